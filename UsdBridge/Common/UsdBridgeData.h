@@ -121,6 +121,13 @@ struct UsdBridgeSettings
   // Output settings
   bool EnablePreviewSurfaceShader;
   bool EnableMdlShader;
+  bool EnableQuantization;          // Write normals, colors and float attributes in half precision where within QuantizationErrorBound.
+  float QuantizationErrorBound;
+  bool EnableGeometryDedup;         // Geometry with identical, non-timevarying content references a single shared prototype prim.
+  bool EnableIndexedPrimvars;       // Write non-timevarying colors and attributes with at most IndexedPrimvarMaxValues distinct values as indexed primvars.
+  uint32_t IndexedPrimvarMaxValues;
+  bool EnableDirectLayerAuthoring;  // Write geometry arrays directly into the attribute specs of a layer, instead of through the stage.
+  float TimeCompressionTolerance;   // Max deviation of transforms and material scalars from linear interpolation between the written keyframes, 0 disables.
 
   // About to be deprecated
   static constexpr bool EnableStTexCoords = false;
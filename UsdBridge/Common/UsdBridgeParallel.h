@@ -0,0 +1,80 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UsdBridgeParallel_h
+#define UsdBridgeParallel_h
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// USD-independent chunked parallel loops for the UsdBridge and its clients
+
+// Below this amount of elements per chunk, thread startup outweighs the gain
+static constexpr size_t UsdBridgeParallelMinChunkSize = 1 << 15;
+
+inline size_t UsdBridgeNumWorkerThreads()
+{
+  unsigned int numHwThreads = std::thread::hardware_concurrency();
+  return numHwThreads ? numHwThreads : 1;
+}
+
+// Number of chunks that [0,numElements) is split into by UsdBridgeParallelFor.
+// Callers that run multiple passes over the same range (eg. count + scatter) should
+// determine this once and pass it to every pass, so chunk boundaries match.
+inline size_t UsdBridgeNumParallelChunks(size_t numElements, size_t minChunkSize = UsdBridgeParallelMinChunkSize)
+{
+  size_t maxChunks = (numElements + minChunkSize - 1) / minChunkSize;
+  return std::max<size_t>(1, std::min(maxChunks, UsdBridgeNumWorkerThreads()));
+}
+
+// Calls func(chunkIdx, begin, end) for numChunks contiguous ranges covering [0,numElements).
+// The first chunk runs on the calling thread, returns when all chunks have finished.
+template<typename FuncType>
+void UsdBridgeParallelFor(size_t numElements, size_t numChunks, const FuncType& func)
+{
+  if(numChunks <= 1)
+  {
+    func(size_t(0), size_t(0), numElements);
+    return;
+  }
+
+  size_t chunkSize = (numElements + numChunks - 1) / numChunks;
+
+  std::vector<std::thread> workers;
+  workers.reserve(numChunks-1);
+  for(size_t chunkIdx = 1; chunkIdx < numChunks; ++chunkIdx)
+  {
+    size_t begin = std::min(chunkIdx*chunkSize, numElements);
+    size_t end = std::min(begin+chunkSize, numElements);
+    workers.emplace_back([&func, chunkIdx, begin, end]() { func(chunkIdx, begin, end); });
+  }
+
+  func(size_t(0), size_t(0), std::min(chunkSize, numElements));
+
+  for(std::thread& worker : workers)
+    worker.join();
+}
+
+template<typename FuncType>
+void UsdBridgeParallelFor(size_t numElements, const FuncType& func)
+{
+  UsdBridgeParallelFor(numElements, UsdBridgeNumParallelChunks(numElements), func);
+}
+
+// In-place exclusive prefix sum over per-chunk counts, returns the total
+template<typename CountType>
+CountType UsdBridgeExclusivePrefixSum(std::vector<CountType>& counts)
+{
+  CountType total = 0;
+  for(CountType& count : counts)
+  {
+    CountType value = count;
+    count = total;
+    total += value;
+  }
+  return total;
+}
+
+#endif
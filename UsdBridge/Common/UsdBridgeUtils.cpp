@@ -2,6 +2,11 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "UsdBridgeUtils.h"
+#include "UsdBridgeParallel.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
 
 
 const char* UsdBridgeTypeToString(UsdBridgeType type)
@@ -58,4 +63,311 @@ const char* UsdBridgeTypeToString(UsdBridgeType type)
     default: typeStr = "UNDEFINED"; break;
   }
   return typeStr;
-}
\ No newline at end of file
+}
+
+size_t UsdBridgeTypeSize(UsdBridgeType type)
+{
+  if(type == UsdBridgeType::BOOL)
+    return sizeof(bool);
+  if(type == UsdBridgeType::UNDEFINED)
+    return 0;
+
+  // Apart from BOOL, every component count has the same group of fundamental types (starting at UCHAR)
+  const int numTypesPerGroup = (int)UsdBridgeType::UCHAR2 - (int)UsdBridgeType::UCHAR;
+  int typeIdx = (int)type - (int)UsdBridgeType::UCHAR;
+  int numComponents = typeIdx / numTypesPerGroup + 1;
+  UsdBridgeType fundamentalType = (UsdBridgeType)(typeIdx % numTypesPerGroup + (int)UsdBridgeType::UCHAR);
+
+  size_t componentSize = 0;
+  switch(fundamentalType)
+  {
+    case UsdBridgeType::UCHAR: 
+    case UsdBridgeType::CHAR: componentSize = 1; break;
+    case UsdBridgeType::USHORT:
+    case UsdBridgeType::SHORT: 
+    case UsdBridgeType::HALF: componentSize = 2; break;
+    case UsdBridgeType::UINT:
+    case UsdBridgeType::INT: 
+    case UsdBridgeType::FLOAT: componentSize = 4; break;
+    case UsdBridgeType::ULONG:
+    case UsdBridgeType::LONG: 
+    case UsdBridgeType::DOUBLE: componentSize = 8; break;
+    default: break;
+  }
+  return componentSize * numComponents;
+}
+
+namespace
+{
+  // Inputs are hashed in fixed-size blocks, so the result does not depend on the amount of chunks processed in parallel
+  constexpr size_t HashBlockSize = 1 << 20;
+  constexpr uint64_t HashMultiplier = 0xc6a4a7935bd1e995ull;
+
+  uint64_t HashBlock(const unsigned char* data, size_t numBytes, uint64_t seed)
+  {
+    uint64_t hash = seed ^ (numBytes * HashMultiplier);
+
+    size_t numWords = numBytes / sizeof(uint64_t);
+    for(size_t i = 0; i < numWords; ++i)
+    {
+      uint64_t word;
+      std::memcpy(&word, data + i*sizeof(uint64_t), sizeof(uint64_t));
+
+      word *= HashMultiplier;
+      word ^= word >> 47;
+      word *= HashMultiplier;
+
+      hash ^= word;
+      hash *= HashMultiplier;
+    }
+
+    size_t numRemaining = numBytes - numWords*sizeof(uint64_t);
+    if(numRemaining)
+    {
+      uint64_t word = 0;
+      std::memcpy(&word, data + numWords*sizeof(uint64_t), numRemaining);
+      hash ^= word;
+      hash *= HashMultiplier;
+    }
+
+    hash ^= hash >> 47;
+    hash *= HashMultiplier;
+    hash ^= hash >> 47;
+    return hash;
+  }
+}
+
+uint64_t UsdBridgeHashCombine(uint64_t seed, uint64_t value)
+{
+  return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+uint64_t UsdBridgeHashData(const void* data, size_t numBytes, uint64_t seed)
+{
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+  if(!bytes)
+    return UsdBridgeHashCombine(seed, 0);
+
+  size_t numBlocks = (numBytes + HashBlockSize - 1) / HashBlockSize;
+  if(numBlocks <= 1)
+    return UsdBridgeHashCombine(seed, HashBlock(bytes, numBytes, numBytes));
+
+  std::vector<uint64_t> blockHashes(numBlocks);
+  UsdBridgeParallelFor(numBlocks, UsdBridgeNumParallelChunks(numBlocks, 1),
+    [bytes, numBytes, &blockHashes](size_t chunkIdx, size_t blockBegin, size_t blockEnd)
+    {
+      for(size_t blockIdx = blockBegin; blockIdx < blockEnd; ++blockIdx)
+      {
+        size_t blockStart = blockIdx*HashBlockSize;
+        size_t blockBytes = std::min(HashBlockSize, numBytes - blockStart);
+        blockHashes[blockIdx] = HashBlock(bytes + blockStart, blockBytes, blockIdx);
+      }
+    });
+
+  uint64_t hash = UsdBridgeHashCombine(seed, numBytes);
+  for(uint64_t blockHash : blockHashes)
+    hash = UsdBridgeHashCombine(hash, blockHash);
+  return hash;
+}
+
+bool UsdBridgeIsConstantArray(const void* data, size_t elementSize, uint64_t numElements)
+{
+  if(numElements < 2)
+    return true;
+
+  // Equal to itself shifted by one element means every element equals its predecessor
+  const char* bytes = static_cast<const char*>(data);
+  return std::memcmp(bytes, bytes + elementSize, (numElements-1)*elementSize) == 0;
+}
+
+namespace
+{
+  uint64_t HashElement(const char* element, size_t elementSize)
+  {
+    uint64_t hash = 0;
+    for(size_t offset = 0; offset < elementSize; offset += sizeof(uint64_t))
+    {
+      uint64_t word = 0;
+      std::memcpy(&word, element + offset, std::min(sizeof(uint64_t), elementSize - offset));
+      hash = UsdBridgeHashCombine(hash, word * HashMultiplier);
+    }
+    return hash ^ (hash >> 29);
+  }
+}
+
+bool UsdBridgeFindDistinctElements(const void* data, size_t elementSize, uint64_t numElements, uint32_t maxValues, 
+  std::vector<char>& values, int* indices)
+{
+  // Indices are ints, and there can't be more distinct values than elements
+  maxValues = std::min(maxValues, uint32_t(INT_MAX));
+  uint64_t maxTableValues = std::min(uint64_t(maxValues), numElements);
+
+  // Open addressing table of value indices, kept at most half full
+  size_t tableSize = 16;
+  while(tableSize < size_t(maxTableValues)*2)
+    tableSize *= 2;
+  size_t tableMask = tableSize - 1;
+  std::vector<int> table(tableSize, -1);
+
+  const char* elements = static_cast<const char*>(data);
+  int numValues = 0;
+  values.clear();
+  for(uint64_t eltIdx = 0; eltIdx < numElements; ++eltIdx)
+  {
+    const char* element = elements + eltIdx*elementSize;
+
+    size_t slot = HashElement(element, elementSize) & tableMask;
+    while(table[slot] != -1 && std::memcmp(values.data() + table[slot]*elementSize, element, elementSize) != 0)
+      slot = (slot + 1) & tableMask;
+
+    if(table[slot] == -1)
+    {
+      if(uint32_t(numValues) == maxValues)
+        return false;
+      table[slot] = numValues++;
+      values.insert(values.end(), element, element + elementSize);
+    }
+    indices[eltIdx] = table[slot];
+  }
+  return true;
+}
+
+namespace
+{
+  // Points are reduced in blocks, with a min and max per component of every point in the block. The lanes are
+  // independent, so the loops over a block map onto vector instructions; they are folded into a single extent at the end.
+  constexpr size_t ExtentBlockPoints = 8;
+  constexpr size_t ExtentBlockLanes = ExtentBlockPoints*3;
+
+  template<typename PointType, typename WidthType>
+  void ReduceExtent(const PointType* points, const WidthType* widths, size_t begin, size_t end, UsdBridgeExtent& extent)
+  {
+    PointType laneMin[ExtentBlockLanes];
+    PointType laneMax[ExtentBlockLanes];
+    PointType laneRadius[ExtentBlockLanes];
+    for(size_t lane = 0; lane < ExtentBlockLanes; ++lane)
+    {
+      PointType radius = widths ? PointType(widths[begin]*0.5) : PointType(0);
+      laneMin[lane] = points[begin*3 + lane%3] - radius;
+      laneMax[lane] = points[begin*3 + lane%3] + radius;
+      laneRadius[lane] = 0;
+    }
+
+    size_t numBlocks = (end - begin) / ExtentBlockPoints;
+    for(size_t blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+    {
+      size_t firstPoint = begin + blockIdx*ExtentBlockPoints;
+      const PointType* blockPoints = points + firstPoint*3;
+      if(widths)
+      {
+        for(size_t lane = 0; lane < ExtentBlockLanes; ++lane)
+          laneRadius[lane] = PointType(widths[firstPoint + lane/3]*0.5);
+      }
+      for(size_t lane = 0; lane < ExtentBlockLanes; ++lane)
+      {
+        PointType lo = blockPoints[lane] - laneRadius[lane];
+        PointType hi = blockPoints[lane] + laneRadius[lane];
+        laneMin[lane] = lo < laneMin[lane] ? lo : laneMin[lane];
+        laneMax[lane] = hi > laneMax[lane] ? hi : laneMax[lane];
+      }
+    }
+
+    for(size_t pointIdx = begin + numBlocks*ExtentBlockPoints; pointIdx < end; ++pointIdx)
+    {
+      PointType radius = widths ? PointType(widths[pointIdx]*0.5) : PointType(0);
+      for(size_t comp = 0; comp < 3; ++comp)
+      {
+        PointType lo = points[pointIdx*3 + comp] - radius;
+        PointType hi = points[pointIdx*3 + comp] + radius;
+        laneMin[comp] = lo < laneMin[comp] ? lo : laneMin[comp];
+        laneMax[comp] = hi > laneMax[comp] ? hi : laneMax[comp];
+      }
+    }
+
+    // Rounding to float is monotonic, so the extent of the converted points follows from the converted bounds
+    for(size_t comp = 0; comp < 3; ++comp)
+    {
+      PointType compMin = laneMin[comp];
+      PointType compMax = laneMax[comp];
+      for(size_t lane = comp+3; lane < ExtentBlockLanes; lane += 3)
+      {
+        compMin = laneMin[lane] < compMin ? laneMin[lane] : compMin;
+        compMax = laneMax[lane] > compMax ? laneMax[lane] : compMax;
+      }
+      extent.Min[comp] = float(compMin);
+      extent.Max[comp] = float(compMax);
+    }
+  }
+
+  template<typename PointType, typename WidthType>
+  void ComputeExtent(const PointType* points, const WidthType* widths, uint64_t numPoints, UsdBridgeExtent& extent)
+  {
+    size_t numChunks = UsdBridgeNumParallelChunks(numPoints);
+    std::vector<UsdBridgeExtent> chunkExtents(numChunks);
+    std::vector<char> chunkHasPoints(numChunks, 0);
+    UsdBridgeParallelFor(numPoints, numChunks, [points, widths, &chunkExtents, &chunkHasPoints](size_t chunkIdx, size_t begin, size_t end)
+      {
+        if(begin < end)
+        {
+          ReduceExtent(points, widths, begin, end, chunkExtents[chunkIdx]);
+          chunkHasPoints[chunkIdx] = 1;
+        }
+      });
+
+    // The first chunk is never empty
+    extent = chunkExtents[0];
+    for(size_t chunkIdx = 1; chunkIdx < numChunks; ++chunkIdx)
+    {
+      if(!chunkHasPoints[chunkIdx])
+        continue;
+      for(size_t comp = 0; comp < 3; ++comp)
+      {
+        extent.Min[comp] = std::min(extent.Min[comp], chunkExtents[chunkIdx].Min[comp]);
+        extent.Max[comp] = std::max(extent.Max[comp], chunkExtents[chunkIdx].Max[comp]);
+      }
+    }
+  }
+
+  template<typename PointType>
+  bool ComputeExtent(const PointType* points, uint64_t numPoints, const void* widths, UsdBridgeType widthsType, UsdBridgeExtent& extent)
+  {
+    if(!widths)
+    {
+      ComputeExtent(points, static_cast<const float*>(nullptr), numPoints, extent);
+      return true;
+    }
+
+    switch(widthsType)
+    {
+      case UsdBridgeType::FLOAT: ComputeExtent(points, static_cast<const float*>(widths), numPoints, extent); return true;
+      case UsdBridgeType::DOUBLE: ComputeExtent(points, static_cast<const double*>(widths), numPoints, extent); return true;
+      default: return false;
+    }
+  }
+}
+
+bool UsdBridgeComputeExtent(const void* points, UsdBridgeType pointsType, uint64_t numPoints,
+  const void* widths, UsdBridgeType widthsType, double uniformWidth, UsdBridgeExtent& extent)
+{
+  if(!points || !numPoints)
+    return false;
+
+  bool result = false;
+  switch(pointsType)
+  {
+    case UsdBridgeType::FLOAT3: result = ComputeExtent(static_cast<const float*>(points), numPoints, widths, widthsType, extent); break;
+    case UsdBridgeType::DOUBLE3: result = ComputeExtent(static_cast<const double*>(points), numPoints, widths, widthsType, extent); break;
+    default: break;
+  }
+
+  if(result && !widths && uniformWidth != 0.0)
+  {
+    float radius = float(uniformWidth*0.5);
+    for(size_t comp = 0; comp < 3; ++comp)
+    {
+      extent.Min[comp] -= radius;
+      extent.Max[comp] += radius;
+    }
+  }
+  return result;
+}
@@ -6,8 +6,38 @@
 
 #include "UsdBridgeData.h"
 
+#include <vector>
+
 // USD-independent utils for the UsdBridge
 
 const char* UsdBridgeTypeToString(UsdBridgeType type);
 
+size_t UsdBridgeTypeSize(UsdBridgeType type); // Size in bytes of a single (multi-component) element, 0 for UNDEFINED
+
+// Content hashing, independent of the number of threads used to compute it
+uint64_t UsdBridgeHashData(const void* data, size_t numBytes, uint64_t seed = 0);
+uint64_t UsdBridgeHashCombine(uint64_t seed, uint64_t value);
+
+// Whether all numElements elements of elementSize bytes are bitwise equal, stops at the first difference
+bool UsdBridgeIsConstantArray(const void* data, size_t elementSize, uint64_t numElements);
+
+// Finds the distinct elements of an array, of which there may be at most maxValues. On success, values holds the distinct elements
+// in order of first occurrence and indices (numElements entries) refers to them per element.
+// Returns false as soon as more than maxValues distinct elements are encountered.
+bool UsdBridgeFindDistinctElements(const void* data, size_t elementSize, uint64_t numElements, uint32_t maxValues, 
+  std::vector<char>& values, int* indices);
+
+// Axis-aligned bounds, in the single precision of the points written to USD
+struct UsdBridgeExtent
+{
+  float Min[3];
+  float Max[3];
+};
+
+// Computes the bounds of numPoints FLOAT3 or DOUBLE3 points in parallel. Each point is grown by half its width, 
+// taken from widths (FLOAT or DOUBLE, one per point) if not null, otherwise from uniformWidth.
+// Returns false for unsupported types or if there are no points.
+bool UsdBridgeComputeExtent(const void* points, UsdBridgeType pointsType, uint64_t numPoints,
+  const void* widths, UsdBridgeType widthsType, double uniformWidth, UsdBridgeExtent& extent);
+
 #endif
\ No newline at end of file
@@ -5,9 +5,12 @@
 
 #include "UsdBridgeUsdWriter.h"
 #include "UsdBridgeCaches.h"
+#include "UsdBridgeUtils.h"
 
 #include <string>
 #include <memory>
+#include <cstdio>
+#include <algorithm>
 
 #define BRIDGE_CACHE Internals->Cache
 #define BRIDGE_USDWRITER Internals->UsdWriter
@@ -24,9 +27,12 @@ namespace
   const char* const fieldPathCp = "spatialfields";
   const char* const materialPathCp = "materials";
   const char* const samplerPathCp = "samplers";
+  const char* const geomPrototypePathCp = "geometryprototypes";
+  const char* const geomLodPathCp = "geometrylods";
 
   // Parent path extensions for references in parent classes (Reference path)
   const char* const instancePathRp = "instances";
+  const char* const instancerPathRp = "instancers";
   const char* const surfacePathRp = "surfaces";
   const char* const volumePathRp = "volumes";
   const char* const geometryPathRp = "geometry"; // created in surfaces parent class
@@ -43,10 +49,111 @@ namespace
   // Postfixes for clip stage names
   const char* const geomClipPf = "_Geom_";
 
+  // Prefix for the names of shared geometry prototypes, followed by their content hash
+  const char* const geomPrototypeNamePf = "GeomProto_";
+
+  // Postfix for the names of reduced-resolution geometry levels, following the geometry name
+  const char* const geomLodPf = "_Lod";
+
   bool PrimIsNew(const BoolEntryPair& createResult)
   {
     return !createResult.first.first && !createResult.first.second;
   }
+
+  template<typename GeomDataType>
+  bool GeometryIsDedupable(const GeomDataType& geomData)
+  {
+#ifdef TIME_BASED_CACHING
+    // A reference to a prototype applies to all timesteps at once, so only uniform data qualifies
+    return geomData.TimeVarying == GeomDataType::DataMemberId::NONE;
+#else
+    return true;
+#endif
+  }
+
+  uint64_t HashGeomArray(uint64_t hash, const void* data, UsdBridgeType dataType, uint64_t numElements)
+  {
+    hash = UsdBridgeHashCombine(hash, static_cast<uint64_t>(dataType));
+    return UsdBridgeHashData(data, data ? UsdBridgeTypeSize(dataType) * numElements : 0, hash);
+  }
+
+  uint64_t HashGeomValue(uint64_t hash, double value)
+  {
+    return UsdBridgeHashData(&value, sizeof(value), hash);
+  }
+
+  uint64_t HashGeomAttributes(uint64_t hash, const UsdBridgeAttribute* attributes, uint32_t numAttributes, uint64_t numPoints, uint64_t numPrims)
+  {
+    hash = UsdBridgeHashCombine(hash, numAttributes);
+    for (uint32_t attribIdx = 0; attribIdx < numAttributes; ++attribIdx)
+    {
+      const UsdBridgeAttribute& attrib = attributes[attribIdx];
+      hash = UsdBridgeHashCombine(hash, attrib.PerPrimData);
+      hash = HashGeomArray(hash, attrib.Data, attrib.DataType, attrib.PerPrimData ? numPrims : numPoints);
+    }
+    return hash;
+  }
+
+  // The content hashes cover everything that ends up in the geometry prim (including the data layout).
+  // Differently seeded hashes of the same content are independent, so a second one can verify a match of the first.
+  const uint64_t geomContentNameSeed = 0;
+  const uint64_t geomContentKeySeed = 0x9e3779b97f4a7c15ull;
+
+  uint64_t HashGeometryContent(const UsdBridgeMeshData& meshData, uint64_t seed)
+  {
+    uint64_t numPrims = meshData.FaceVertexCount ? meshData.NumIndices / meshData.FaceVertexCount : 0;
+
+    uint64_t hash = UsdBridgeHashCombine(seed, static_cast<uint64_t>(UsdBridgeMeshData::GeomType));
+    hash = UsdBridgeHashCombine(hash, meshData.NumPoints);
+    hash = UsdBridgeHashCombine(hash, meshData.NumIndices);
+    hash = UsdBridgeHashCombine(hash, meshData.FaceVertexCount);
+    hash = UsdBridgeHashCombine(hash, meshData.PerPrimNormals);
+    hash = UsdBridgeHashCombine(hash, meshData.PerPrimColors);
+    hash = HashGeomArray(hash, meshData.Points, meshData.PointsType, meshData.NumPoints);
+    hash = HashGeomArray(hash, meshData.Normals, meshData.NormalsType, meshData.PerPrimNormals ? numPrims : meshData.NumPoints);
+    hash = HashGeomArray(hash, meshData.Colors, meshData.ColorsType, meshData.PerPrimColors ? numPrims : meshData.NumPoints);
+    hash = HashGeomArray(hash, meshData.Indices, meshData.IndicesType, meshData.NumIndices);
+    return HashGeomAttributes(hash, meshData.Attributes, meshData.NumAttributes, meshData.NumPoints, numPrims);
+  }
+
+  uint64_t HashGeometryContent(const UsdBridgeInstancerData& instancerData, uint64_t seed)
+  {
+    uint64_t numPoints = instancerData.NumPoints;
+
+    uint64_t hash = UsdBridgeHashCombine(seed, static_cast<uint64_t>(UsdBridgeInstancerData::GeomType));
+    hash = UsdBridgeHashCombine(hash, numPoints);
+    hash = UsdBridgeHashCombine(hash, instancerData.UsePointInstancer);
+    hash = UsdBridgeHashData(instancerData.Shapes, instancerData.NumShapes * sizeof(UsdBridgeInstancerData::InstanceShape), hash);
+    hash = HashGeomValue(hash, instancerData.UniformScale);
+    hash = HashGeomArray(hash, instancerData.Points, instancerData.PointsType, numPoints);
+    hash = HashGeomArray(hash, instancerData.ShapeIndices, UsdBridgeType::INT, numPoints);
+    hash = HashGeomArray(hash, instancerData.Scales, instancerData.ScalesType, numPoints);
+    hash = HashGeomArray(hash, instancerData.Orientations, instancerData.OrientationsType, numPoints);
+    hash = HashGeomArray(hash, instancerData.Colors, instancerData.ColorsType, numPoints);
+    hash = HashGeomArray(hash, instancerData.LinearVelocities, UsdBridgeType::FLOAT3, numPoints);
+    hash = HashGeomArray(hash, instancerData.AngularVelocities, UsdBridgeType::FLOAT3, numPoints);
+    hash = HashGeomArray(hash, instancerData.InstanceIds, instancerData.InstanceIdsType, numPoints);
+    hash = HashGeomArray(hash, instancerData.InvisibleIds, instancerData.InvisibleIdsType, instancerData.NumInvisibleIds);
+    return HashGeomAttributes(hash, instancerData.Attributes, instancerData.NumAttributes, numPoints, numPoints);
+  }
+
+  uint64_t HashGeometryContent(const UsdBridgeCurveData& curveData, uint64_t seed)
+  {
+    uint64_t numPrims = curveData.NumCurveLengths;
+
+    uint64_t hash = UsdBridgeHashCombine(seed, static_cast<uint64_t>(UsdBridgeCurveData::GeomType));
+    hash = UsdBridgeHashCombine(hash, curveData.NumPoints);
+    hash = UsdBridgeHashCombine(hash, numPrims);
+    hash = UsdBridgeHashCombine(hash, curveData.PerPrimNormals);
+    hash = UsdBridgeHashCombine(hash, curveData.PerPrimColors);
+    hash = HashGeomValue(hash, curveData.UniformScale);
+    hash = HashGeomArray(hash, curveData.Points, curveData.PointsType, curveData.NumPoints);
+    hash = HashGeomArray(hash, curveData.Normals, curveData.NormalsType, curveData.PerPrimNormals ? numPrims : curveData.NumPoints);
+    hash = HashGeomArray(hash, curveData.Colors, curveData.ColorsType, curveData.PerPrimColors ? numPrims : curveData.NumPoints);
+    hash = HashGeomArray(hash, curveData.Scales, curveData.ScalesType, curveData.NumPoints);
+    hash = HashGeomArray(hash, curveData.CurveLengths, UsdBridgeType::INT, numPrims);
+    return HashGeomAttributes(hash, curveData.Attributes, curveData.NumAttributes, curveData.NumPoints, numPrims);
+  }
 }
 
 typedef UsdBridgePrimCacheManager::PrimCacheIterator PrimCacheIterator;
@@ -138,10 +245,14 @@ struct UsdBridgeInternals
   BoolEntryPair FindOrCreatePrim(const char* category, const char* name, ResourceCollectFunc collectFunc = nullptr);
   void FindAndDeletePrim(const UsdBridgeHandle& handle);
 
+  template<typename GeomDataType>
+  bool UpdateGeometryPrototype(UsdBridgePrimCache* geomCache, const GeomDataType& geomData, double timeStep);
+
   template<class T>
   const UsdBridgePrimCacheList& ExtractPrimCaches(const T* handles, uint64_t numHandles);
 
   const UsdBridgePrimCacheList& ToCacheList(UsdBridgePrimCache* primCache);
+  const UsdBridgePrimCacheList& ToGeometryCacheList(UsdBridgePrimCache* geometryCache); // Includes the geometry's levels of detail
 
   // Cache
   UsdBridgePrimCacheManager Cache;
@@ -198,6 +309,55 @@ void UsdBridgeInternals::FindAndDeletePrim(const UsdBridgeHandle& handle)
   Cache.RemovePrimCache(it);
 }
 
+template<typename GeomDataType>
+bool UsdBridgeInternals::UpdateGeometryPrototype(UsdBridgePrimCache* geomCache, const GeomDataType& geomData, double timeStep)
+{
+  UsdBridgePrimCache* protoCache = nullptr;
+
+  if (UsdWriter.Settings.EnableGeometryDedup && GeometryIsDedupable(geomData))
+  {
+    // Prototypes are named after their content, so they are never modified after creation
+    char protoName[32];
+    std::snprintf(protoName, sizeof(protoName), "%s%016llx", geomPrototypeNamePf, 
+      static_cast<unsigned long long>(HashGeometryContent(geomData, geomContentNameSeed)));
+    uint64_t contentKey = HashGeometryContent(geomData, geomContentKeySeed);
+
+    BoolEntryPair createResult = FindOrCreatePrim(geomPrototypePathCp, protoName);
+    protoCache = createResult.second;
+    bool cacheExists = createResult.first.second;
+
+    if (!cacheExists)
+    {
+      UsdStageRefPtr sceneStage = UsdWriter.GetSceneStage();
+      UsdWriter.InitializeUsdGeometry(sceneStage, protoCache->PrimPath, geomData, true);
+      UsdWriter.UpdateUsdGeometry(sceneStage, protoCache->PrimPath, geomData, timeStep);
+      protoCache->GeomContentKey = contentKey;
+    }
+    else if (protoCache->GeomContentKey != contentKey)
+    {
+      // Different content with the same name hash; the geometry keeps its own data instead
+      std::string message = "Geometry content hash collision with prototype " + protoCache->PrimPath.GetString() + ", geometry is not deduplicated.";
+      UsdWriter.LogCallback(UsdBridgeLogLevel::WARNING, UsdWriter.LogUserData, message.c_str());
+      protoCache = nullptr;
+    }
+  }
+
+  if (protoCache != geomCache->GeomPrototype)
+  {
+    // An unreferenced prototype is kept until garbage collection, in case its content reappears
+    if (geomCache->GeomPrototype)
+      Cache.RemoveChild(geomCache, geomCache->GeomPrototype);
+    if (protoCache)
+      Cache.AddChild(geomCache, protoCache);
+
+    UsdWriter.SetGeometryPrototypeRef(geomCache, protoCache);
+    geomCache->GeomPrototype = protoCache;
+    geomCache->MeshTopologies.clear(); // Referencing a prototype clears the values of the geometry prim
+  }
+
+  return protoCache != nullptr;
+}
+
 template<class T>
 const UsdBridgePrimCacheList& UsdBridgeInternals::ExtractPrimCaches(const T* handles, uint64_t numHandles)
 {
@@ -216,6 +376,14 @@ const UsdBridgePrimCacheList& UsdBridgeInternals::ToCacheList(UsdBridgePrimCache
   return TempPrimCaches;
 }
 
+const UsdBridgePrimCacheList& UsdBridgeInternals::ToGeometryCacheList(UsdBridgePrimCache* geometryCache)
+{
+  ToCacheList(geometryCache);
+  if (geometryCache && geometryCache->GeomLod)
+    TempPrimCaches.push_back(geometryCache->GeomLod);
+  return TempPrimCaches;
+}
+
 UsdBridge::UsdBridge(const UsdBridgeSettings& settings) 
   : Internals(new UsdBridgeInternals(settings))
   , SessionValid(false)
@@ -514,6 +682,12 @@ void UsdBridge::DeleteGeometry(UsdGeometryHandle handle)
 {
   if (handle.value == nullptr) return;
 
+  UsdBridgePrimCache* cache = BRIDGE_CACHE.ConvertToPrimCache(handle);
+  if (cache->GeomPrototype)
+    BRIDGE_CACHE.RemoveChild(cache, cache->GeomPrototype);
+  if (cache->GeomLod)
+    BRIDGE_CACHE.RemoveChild(cache, cache->GeomLod);
+
   Internals->FindAndDeletePrim(handle);
 }
 
@@ -559,6 +733,49 @@ void UsdBridge::SetInstanceRefs(UsdWorldHandle world, const UsdInstanceHandle* i
   SetNoClipRefs(world, instances, numInstances, instancePathRp, timeVarying, timeStep);
 }
 
+void UsdBridge::SetInstancerRefs(UsdWorldHandle world, const UsdInstanceHandle* instances, const UsdGroupHandle* groups, const float* transforms, uint64_t numInstances, bool timeVarying, double timeStep)
+{
+  if (world.value == nullptr) return;
+
+  UsdBridgePrimCache* worldCache = BRIDGE_CACHE.ConvertToPrimCache(world);
+
+  // The instances have no referencing prims below the world, so their reference counts are kept directly.
+  // New references are added before the old ones are released, so instances that remain are never unreferenced.
+  UsdBridgePrimCacheList oldInstances;
+  oldInstances.swap(worldCache->InstancerInstances);
+  worldCache->InstancerInstances = Internals->ExtractPrimCaches<UsdInstanceHandle>(instances, numInstances);
+  for (UsdBridgePrimCache* instanceCache : worldCache->InstancerInstances)
+    BRIDGE_CACHE.AddChild(worldCache, instanceCache);
+  for (UsdBridgePrimCache* instanceCache : oldInstances)
+    BRIDGE_CACHE.RemoveChild(worldCache, instanceCache);
+
+  // Bucket the instances per group, in order of first occurrence
+  UsdBridgePrimCacheList groupCaches;
+  std::vector<std::vector<uint64_t>> groupInstanceIds;
+  std::unordered_map<UsdBridgePrimCache*, size_t> groupBuckets;
+  for (uint64_t i = 0; i < numInstances; ++i)
+  {
+    if (groups[i].value == nullptr)
+      continue;
+
+    UsdBridgePrimCache* groupCache = BRIDGE_CACHE.ConvertToPrimCache(groups[i]);
+    auto bucketIt = groupBuckets.emplace(groupCache, groupCaches.size());
+    if (bucketIt.second)
+    {
+      groupCaches.push_back(groupCache);
+      groupInstanceIds.emplace_back();
+    }
+    groupInstanceIds[bucketIt.first->second].push_back(i);
+  }
+
+  BRIDGE_USDWRITER.ManageUnusedRefs(worldCache, groupCaches, instancerPathRp, timeVarying, timeStep, Internals->RefModCallbacks.AtRemoveRef);
+  for (size_t i = 0; i < groupCaches.size(); ++i)
+  {
+    BRIDGE_USDWRITER.UpdateUsdInstancer(worldCache, groupCaches[i], instancerPathRp, transforms, groupInstanceIds[i].data(), groupInstanceIds[i].size(),
+      timeVarying, timeStep, Internals->RefModCallbacks);
+  }
+}
+
 void UsdBridge::SetGroupRef(UsdInstanceHandle instance, UsdGroupHandle group, bool timeVarying, double timeStep)
 {
   if (instance.value == nullptr) return;
@@ -598,10 +815,17 @@ void UsdBridge::SetGeometryRef(UsdSurfaceHandle surface, UsdGeometryHandle geome
   UsdBridgePrimCache* geometryCache = BRIDGE_CACHE.ConvertToPrimCache(geometry);
 
   bool timeVarying = false;
-  BRIDGE_USDWRITER.ManageUnusedRefs(surfaceCache, Internals->ToCacheList(geometryCache), geometryPathRp, timeVarying, timeStep, Internals->RefModCallbacks.AtRemoveRef);
-  SdfPath refGeomPath = BRIDGE_USDWRITER.AddRef(surfaceCache, geometryCache, geometryPathRp, timeVarying, true, true, geomClipPf, timeStep, geomTimeStep, Internals->RefModCallbacks);
+  bool geomValueClip = !geometryCache->GeomPrototype; // Deduplicated geometry has the same data at all timesteps and no clip stages
+  BRIDGE_USDWRITER.ManageUnusedRefs(surfaceCache, Internals->ToGeometryCacheList(geometryCache), geometryPathRp, timeVarying, timeStep, Internals->RefModCallbacks.AtRemoveRef);
+  SdfPath refGeomPath = BRIDGE_USDWRITER.AddRef(surfaceCache, geometryCache, geometryPathRp, timeVarying, geomValueClip, geomValueClip, geomClipPf, timeStep, geomTimeStep, Internals->RefModCallbacks);
 
   BRIDGE_USDWRITER.UnbindMaterialFromGeom(refGeomPath);
+
+  if (geometryCache->GeomLod)
+  {
+    SdfPath refLodPath = BRIDGE_USDWRITER.AddRef_NoClip(surfaceCache, geometryCache->GeomLod, geometryPathRp, timeVarying, timeStep, Internals->RefModCallbacks);
+    BRIDGE_USDWRITER.UnbindMaterialFromGeom(refLodPath);
+  }
 }
 
 void UsdBridge::SetGeometryMaterialRef(UsdSurfaceHandle surface, UsdGeometryHandle geometry, UsdMaterialHandle material, double timeStep, double geomTimeStep, double matTimeStep)
@@ -614,16 +838,24 @@ void UsdBridge::SetGeometryMaterialRef(UsdSurfaceHandle surface, UsdGeometryHand
 
   bool timeVarying = false;
   bool valueClip = true;
+  bool geomValueClip = !geometryCache->GeomPrototype; // Deduplicated geometry has the same data at all timesteps and no clip stages
   // Remove any dangling references
-  BRIDGE_USDWRITER.ManageUnusedRefs(surfaceCache, Internals->ToCacheList(geometryCache), geometryPathRp, timeVarying, timeStep, Internals->RefModCallbacks.AtRemoveRef);
+  BRIDGE_USDWRITER.ManageUnusedRefs(surfaceCache, Internals->ToGeometryCacheList(geometryCache), geometryPathRp, timeVarying, timeStep, Internals->RefModCallbacks.AtRemoveRef);
   BRIDGE_USDWRITER.ManageUnusedRefs(surfaceCache, Internals->ToCacheList(materialCache), materialPathRp, timeVarying, timeStep, Internals->RefModCallbacks.AtRemoveRef);
 
   // Update the references
-  SdfPath refGeomPath = BRIDGE_USDWRITER.AddRef(surfaceCache, geometryCache, geometryPathRp, timeVarying, valueClip, true, geomClipPf, timeStep, geomTimeStep, Internals->RefModCallbacks); // Can technically be timeVarying, but would be a bit confusing. Instead, timevary the surface.
+  SdfPath refGeomPath = BRIDGE_USDWRITER.AddRef(surfaceCache, geometryCache, geometryPathRp, timeVarying, geomValueClip, geomValueClip, geomClipPf, timeStep, geomTimeStep, Internals->RefModCallbacks); // Can technically be timeVarying, but would be a bit confusing. Instead, timevary the surface.
   SdfPath refMatPath = BRIDGE_USDWRITER.AddRef(surfaceCache, materialCache, materialPathRp, timeVarying, valueClip, false, nullptr, timeStep, matTimeStep, Internals->RefModCallbacks);
 
   // Bind the referencing material to the referencing geom prim (as they are within same scope in this usd prim)
   BRIDGE_USDWRITER.BindMaterialToGeom(refGeomPath, refMatPath);
+
+  // Levels of detail are not retimed, their data is authored on the scenestage at the geometry's timesteps
+  if (geometryCache->GeomLod)
+  {
+    SdfPath refLodPath = BRIDGE_USDWRITER.AddRef_NoClip(surfaceCache, geometryCache->GeomLod, geometryPathRp, timeVarying, timeStep, Internals->RefModCallbacks);
+    BRIDGE_USDWRITER.BindMaterialToGeom(refLodPath, refMatPath);
+  }
 }
 
 void UsdBridge::SetSpatialFieldRef(UsdVolumeHandle volume, UsdSpatialFieldHandle field, double timeStep, double fieldTimeStep)
@@ -685,6 +917,19 @@ void UsdBridge::DeleteInstanceRefs(UsdWorldHandle world, bool timeVarying, doubl
   DeleteAllRefs(world, instancePathRp, timeVarying, timeStep);
 }
 
+void UsdBridge::DeleteInstancerRefs(UsdWorldHandle world, bool timeVarying, double timeStep)
+{
+  if (world.value == nullptr) return;
+
+  UsdBridgePrimCache* worldCache = BRIDGE_CACHE.ConvertToPrimCache(world);
+  for (UsdBridgePrimCache* instanceCache : worldCache->InstancerInstances)
+    BRIDGE_CACHE.RemoveChild(worldCache, instanceCache);
+  worldCache->InstancerInstances.clear();
+  worldCache->InstancerArrays.clear();
+
+  DeleteAllRefs(world, instancerPathRp, timeVarying, timeStep);
+}
+
 void UsdBridge::DeleteGroupRef(UsdInstanceHandle instance, bool timeVarying, double timeStep)
 {
   DeleteAllRefs(instance, nullptr, timeVarying, timeStep);
@@ -745,7 +990,10 @@ void UsdBridge::SetInstanceTransform(UsdInstanceHandle instance, float* transfor
 
   SdfPath transformPath = cache->PrimPath;// .AppendPath(SdfPath(transformAttribPf));
 
-  BRIDGE_USDWRITER.UpdateUsdTransform(transformPath, transform, timeVarying, timeStep);
+  // Data updates only author properties of existing prims, so their change processing can be batched.
+  // Prim creation stays outside of change blocks, as the stage doesn't recompose until the outermost block closes.
+  SdfChangeBlock changeBlock;
+  BRIDGE_USDWRITER.UpdateUsdTransform(cache, transformPath, transform, timeVarying, timeStep);
 }
 
 template<typename GeomDataType>
@@ -762,19 +1010,31 @@ void UsdBridge::SetGeometryDataTemplate(UsdGeometryHandle geometry, const GeomDa
     BRIDGE_USDWRITER.UpdateUsdGeometryManifest(cache, geomData);
 #endif
 
-  UsdStageRefPtr geomStage = BRIDGE_USDWRITER.GetTimeVarStage(cache
+  // Deduplicated geometry only references the prototype holding its data, so it gets no (clip) stage of its own
+  if (!Internals->UpdateGeometryPrototype(cache, geomData, timeStep))
+  {
+    UsdStageRefPtr geomStage = BRIDGE_USDWRITER.GetTimeVarStage(cache
 #ifdef TIME_CLIP_STAGES
-    , true, geomClipPf, timeStep
-    , [usdWriter=&BRIDGE_USDWRITER, &geomPath, &geomData] (UsdStageRefPtr geomStage) 
-        { usdWriter->InitializeUsdGeometry(geomStage, geomPath, geomData, false); }
+      , true, geomClipPf, timeStep
+      , [usdWriter=&BRIDGE_USDWRITER, &geomPath, &geomData] (UsdStageRefPtr geomStage) 
+          { usdWriter->InitializeUsdGeometry(geomStage, geomPath, geomData, false); }
 #endif
-  );
-  
-  BRIDGE_USDWRITER.UpdateUsdGeometry(geomStage, geomPath, geomData, timeStep);
+    );
+
+    {
+      SdfChangeBlock changeBlock;
+      BRIDGE_USDWRITER.UpdateUsdGeometry(geomStage, geomPath, geomData, timeStep, cache);
+    }
+
+#if defined(VALUE_CLIP_RETIMING) && !defined(TIME_CLIP_STAGES)
+    if(this->EnableSaving)
+      geomStage->Save(); // Clip stages are saved in batch with the scene
+#endif
+  }
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
-    geomStage->Save();
+    cache->ManifestStage.second->Save(); // May have received shared mesh topology, no-op otherwise
 #endif
 }
 
@@ -793,6 +1053,95 @@ void UsdBridge::SetGeometryData(UsdGeometryHandle geometry, const UsdBridgeCurve
   SetGeometryDataTemplate<UsdBridgeCurveData>(geometry, curveData, timeStep);
 }
 
+void UsdBridge::SetGeometryLods(UsdGeometryHandle geometry, const UsdBridgeMeshData* lodData, uint32_t numLods, double timeStep)
+{
+  if (geometry.value == nullptr) return;
+
+  UsdBridgePrimCache* cache = BRIDGE_CACHE.ConvertToPrimCache(geometry);
+
+  if (numLods == 0)
+  {
+    if (cache->GeomLod)
+    {
+      BRIDGE_USDWRITER.RemoveUsdGeometryLods(cache, cache->GeomLod);
+      BRIDGE_CACHE.RemoveChild(cache, cache->GeomLod);
+      cache->GeomLod = nullptr;
+    }
+    return;
+  }
+
+  if (!cache->GeomLod)
+  {
+    // Surfaces pick up the levels at their next geometry ref update
+    std::string lodName = cache->Name.GetString() + geomLodPf;
+    BoolEntryPair createResult = Internals->FindOrCreatePrim(geomLodPathCp, lodName.c_str());
+    cache->GeomLod = createResult.second;
+    BRIDGE_CACHE.AddChild(cache, cache->GeomLod);
+  }
+
+  BRIDGE_USDWRITER.UpdateUsdGeometryLods(cache, cache->GeomLod, lodData, numLods, timeStep);
+}
+
+template<typename GeomDataType>
+void UsdBridge::SetGeometryChunksTemplate(UsdGeometryHandle geometry, const GeomDataType* chunkData, uint32_t numChunks, double timeStep)
+{
+  if (geometry.value == nullptr || numChunks == 0) return;
+
+  UsdBridgePrimCache* cache = BRIDGE_CACHE.ConvertToPrimCache(geometry);
+
+  if (cache->GeomChunkCount == 0)
+  {
+    // Chunked geometry is not deduplicated
+    if (cache->GeomPrototype)
+    {
+      BRIDGE_CACHE.RemoveChild(cache, cache->GeomPrototype);
+      BRIDGE_USDWRITER.SetGeometryPrototypeRef(cache, nullptr);
+      cache->GeomPrototype = nullptr;
+    }
+
+    BRIDGE_USDWRITER.ConvertToChunkedGeometry(cache);
+    cache->MeshTopologies.clear();
+  }
+
+  // Chunk prims are kept when their amount decreases, as other timesteps may still use them
+  uint32_t prevNumChunks = cache->GeomChunkCount;
+  cache->GeomChunkCount = std::max(prevNumChunks, numChunks);
+
+#ifdef VALUE_CLIP_RETIMING
+  if(cache->TimeVarBitsUpdate(chunkData[0].TimeVarying) || numChunks > prevNumChunks)
+    BRIDGE_USDWRITER.UpdateUsdGeometryChunksManifest(cache, chunkData, numChunks);
+#endif
+
+  UsdStageRefPtr geomStage = BRIDGE_USDWRITER.GetTimeVarStage(cache
+#ifdef TIME_CLIP_STAGES
+    , true, geomClipPf, timeStep
+    , [] (UsdStageRefPtr geomStage) {} // Chunk prims are initialized during their update
+#endif
+  );
+
+  BRIDGE_USDWRITER.UpdateUsdGeometryChunks(geomStage, cache, chunkData, numChunks, timeStep);
+
+#ifdef VALUE_CLIP_RETIMING
+  if(this->EnableSaving)
+  {
+#ifndef TIME_CLIP_STAGES
+    geomStage->Save(); // Clip stages are saved in batch with the scene
+#endif
+    cache->ManifestStage.second->Save(); // May have received shared mesh topology, no-op otherwise
+  }
+#endif
+}
+
+void UsdBridge::SetGeometryChunks(UsdGeometryHandle geometry, const UsdBridgeMeshData* chunkData, uint32_t numChunks, double timeStep)
+{
+  SetGeometryChunksTemplate<UsdBridgeMeshData>(geometry, chunkData, numChunks, timeStep);
+}
+
+void UsdBridge::SetGeometryChunks(UsdGeometryHandle geometry, const UsdBridgeInstancerData* chunkData, uint32_t numChunks, double timeStep)
+{
+  SetGeometryChunksTemplate<UsdBridgeInstancerData>(geometry, chunkData, numChunks, timeStep);
+}
+
 void UsdBridge::SetSpatialFieldData(UsdSpatialFieldHandle field, const UsdBridgeVolumeData& volumeData, double timeStep)
 {
   if (field.value == nullptr) return;
@@ -807,7 +1156,10 @@ void UsdBridge::SetSpatialFieldData(UsdSpatialFieldHandle field, const UsdBridge
   UsdStageRefPtr volumeStage = BRIDGE_USDWRITER.GetTimeVarStage(cache);
 
   // To avoid data duplication when using of clip stages, we need to potentially use the scenestage prim for time-uniform data.
-  BRIDGE_USDWRITER.UpdateUsdVolume(volumeStage, cache->PrimPath, volumeData, timeStep, cache);
+  {
+    SdfChangeBlock changeBlock;
+    BRIDGE_USDWRITER.UpdateUsdVolume(volumeStage, cache->PrimPath, volumeData, timeStep, cache);
+  }
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
@@ -829,7 +1181,11 @@ void UsdBridge::SetMaterialData(UsdMaterialHandle material, const UsdBridgeMater
 
   UsdStageRefPtr materialStage = BRIDGE_USDWRITER.GetTimeVarStage(cache);
 
-  BRIDGE_USDWRITER.UpdateUsdMaterial(materialStage, matPrimPath, matData, timeStep);
+  BRIDGE_USDWRITER.CreateUsdMaterialAttributeReaders(materialStage, matPrimPath, matData, timeStep);
+  {
+    SdfChangeBlock changeBlock;
+    BRIDGE_USDWRITER.UpdateUsdMaterial(materialStage, matPrimPath, matData, timeStep);
+  }
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
@@ -851,7 +1207,10 @@ void UsdBridge::SetSamplerData(UsdSamplerHandle sampler, const UsdBridgeSamplerD
 
   UsdStageRefPtr samplerStage = BRIDGE_USDWRITER.GetTimeVarStage(cache);
   
-  BRIDGE_USDWRITER.UpdateUsdSampler(samplerStage, samplerPrimPath, samplerData, timeStep, cache);
+  {
+    SdfChangeBlock changeBlock;
+    BRIDGE_USDWRITER.UpdateUsdSampler(samplerStage, samplerPrimPath, samplerData, timeStep, cache);
+  }
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
@@ -898,8 +1257,17 @@ void UsdBridge::SaveScene()
 {
   if (!SessionValid) return;
 
+#ifdef VALUE_CLIP_RETIMING
+  BRIDGE_USDWRITER.FlushClipMetaData();
+#endif
+
   if(this->EnableSaving)
+  {
+#ifdef TIME_CLIP_STAGES
+    BRIDGE_USDWRITER.SaveClipStages();
+#endif
     BRIDGE_USDWRITER.GetSceneStage()->Save();
+  }
 }
 
 void UsdBridge::ResetResourceUpdateState()
@@ -909,19 +1277,30 @@ void UsdBridge::ResetResourceUpdateState()
   BRIDGE_USDWRITER.ResetSharedResourceModified();
 }
 
-void UsdBridge::GarbageCollect()
+bool UsdBridge::GarbageCollect(double timeBudget)
 {
-  BRIDGE_CACHE.RemoveUnreferencedPrimCaches(
+  bool collected = BRIDGE_CACHE.RemoveUnreferencedPrimCaches(
     [this](UsdBridgePrimCache* cacheEntry) 
     { 
       if(cacheEntry->ResourceCollect)
         cacheEntry->ResourceCollect(cacheEntry, BRIDGE_USDWRITER);
 
       BRIDGE_USDWRITER.DeletePrim(cacheEntry);
-    }
+    },
+    timeBudget
   );
+#ifdef VALUE_CLIP_RETIMING
+  BRIDGE_USDWRITER.FlushClipMetaData();
+#endif
   if(this->EnableSaving)
+  {
+#ifdef TIME_CLIP_STAGES
+    BRIDGE_USDWRITER.SaveClipStages();
+#endif
     BRIDGE_USDWRITER.GetSceneStage()->Save();
+  }
+
+  return collected;
 }
 
 const char* UsdBridge::GetPrimPath(UsdBridgeHandle* handle)
@@ -49,6 +49,7 @@ class UsdBridge
     void DeleteSampler(UsdSamplerHandle handle);
   
     void SetInstanceRefs(UsdWorldHandle world, const UsdInstanceHandle* instances, uint64_t numInstances, bool timeVarying, double timeStep);
+    void SetInstancerRefs(UsdWorldHandle world, const UsdInstanceHandle* instances, const UsdGroupHandle* groups, const float* transforms, uint64_t numInstances, bool timeVarying, double timeStep); // One point instancer per group, transforms of 16 floats per instance
     void SetGroupRef(UsdInstanceHandle instance, UsdGroupHandle group, bool timeVarying, double timeStep);
     void SetSurfaceRefs(UsdWorldHandle world, const UsdSurfaceHandle* surfaces, uint64_t numSurfaces, bool timeVarying, double timeStep);
     void SetSurfaceRefs(UsdGroupHandle group, const UsdSurfaceHandle* surfaces, uint64_t numSurfaces, bool timeVarying, double timeStep);
@@ -60,6 +61,7 @@ class UsdBridge
     void SetSamplerRefs(UsdMaterialHandle material, const UsdSamplerHandle* samplers, const UsdSamplerRefData* samplerRefData, size_t numSamplers, double timeStep);
   
     void DeleteInstanceRefs(UsdWorldHandle world, bool timeVarying, double timeStep);
+    void DeleteInstancerRefs(UsdWorldHandle world, bool timeVarying, double timeStep);
     void DeleteGroupRef(UsdInstanceHandle instance, bool timeVarying, double timeStep);
     void DeleteSurfaceRefs(UsdWorldHandle world, bool timeVarying, double timeStep);
     void DeleteSurfaceRefs(UsdGroupHandle group, bool timeVarying, double timeStep);
@@ -75,6 +77,9 @@ class UsdBridge
     void SetGeometryData(UsdGeometryHandle geometry, const UsdBridgeMeshData& meshData, double timeStep);
     void SetGeometryData(UsdGeometryHandle geometry, const UsdBridgeInstancerData& instancerData, double timeStep);
     void SetGeometryData(UsdGeometryHandle geometry, const UsdBridgeCurveData& curveData, double timeStep);
+    void SetGeometryLods(UsdGeometryHandle geometry, const UsdBridgeMeshData* lodData, uint32_t numLods, double timeStep); // numLods of 0 removes the levels
+    void SetGeometryChunks(UsdGeometryHandle geometry, const UsdBridgeMeshData* chunkData, uint32_t numChunks, double timeStep); // Once set, the geometry's data is always written as chunks
+    void SetGeometryChunks(UsdGeometryHandle geometry, const UsdBridgeInstancerData* chunkData, uint32_t numChunks, double timeStep);
     void SetSpatialFieldData(UsdSpatialFieldHandle field, const UsdBridgeVolumeData& volumeData, double timeStep);
     void SetMaterialData(UsdMaterialHandle material, const UsdBridgeMaterialData& matData, double timeStep);
     void SetSamplerData(UsdSamplerHandle sampler, const UsdBridgeSamplerData& samplerData, double timeStep);
@@ -86,7 +91,7 @@ class UsdBridge
 
     void ResetResourceUpdateState(); // Eg. clears all dirty flags on shared resources
 
-    void GarbageCollect(); // Deletes all handles without parents (from Set<X>Refs) 
+    bool GarbageCollect(double timeBudget = 0.0); // Deletes all handles without parents (from Set<X>Refs), until timeBudget (in ms, 0 is unlimited) is exceeded. Returns whether all have been deleted.
 
     const char* GetPrimPath(UsdBridgeHandle* handle);
 
@@ -104,6 +109,9 @@ class UsdBridge
     template<typename GeomDataType>
     void SetGeometryDataTemplate(UsdGeometryHandle geometry, const GeomDataType& geomData, double timeStep);
 
+    template<typename GeomDataType>
+    void SetGeometryChunksTemplate(UsdGeometryHandle geometry, const GeomDataType* chunkData, uint32_t numChunks, double timeStep);
+
     template<typename ParentHandleType, typename ChildHandleType>
     void SetNoClipRefs(ParentHandleType parentHandle, const ChildHandleType* childHandles, uint64_t numChildren, 
       const char* refPathExt, bool timeVarying, double timeStep);
@@ -6,19 +6,19 @@ PXR_NAMESPACE_USING_DIRECTIVE
 
 #include "UsdBridgeCaches.h"
 
+#include <chrono>
+
 #ifdef VALUE_CLIP_RETIMING
 constexpr double UsdBridgePrimCache::PrimStageTimeCode;
 #endif
 
 UsdBridgePrimCacheManager::ConstPrimCacheIterator UsdBridgePrimCacheManager::FindPrimCache(const UsdBridgeHandle& handle) const
 {
-  ConstPrimCacheIterator it = std::find_if(
-    UsdPrimCaches.begin(),
-    UsdPrimCaches.end(),
-    [handle](const PrimCacheContainer::value_type& cmp) -> bool { return cmp.second.get() == handle.value;  }
-  );
+  auto indexIt = HandleIndex.find(handle.value);
+  if(indexIt == HandleIndex.end())
+    return UsdPrimCaches.end();
 
-  return it;
+  return UsdPrimCaches.find(*indexIt->second);
 }
 
 UsdBridgePrimCacheManager::ConstPrimCacheIterator UsdBridgePrimCacheManager::CreatePrimCache(const std::string& name, const std::string& fullPath, ResourceCollectFunc collectFunc)
@@ -28,7 +28,19 @@ UsdBridgePrimCacheManager::ConstPrimCacheIterator UsdBridgePrimCacheManager::Cre
 
   // Create new cache entry
   std::unique_ptr<UsdBridgePrimCache> cacheEntry = std::make_unique<UsdBridgePrimCache>(primPath, nameSuffix, collectFunc);
-  return UsdPrimCaches.emplace(name, std::move(cacheEntry)).first;
+  auto result = UsdPrimCaches.emplace(name, std::move(cacheEntry));
+  if(result.second)
+  {
+    HandleIndex.emplace(result.first->second.get(), &result.first->first);
+    QueueForRemoval(result.first->second.get()); // Without a parent, the new entry is collected unless it is referenced before then
+  }
+  return result.first;
+}
+
+void UsdBridgePrimCacheManager::RemovePrimCache(ConstPrimCacheIterator it)
+{
+  HandleIndex.erase(it->second.get());
+  UsdPrimCaches.erase(it);
 }
 
 void UsdBridgePrimCacheManager::InitializeWorldPrim(UsdBridgePrimCache* worldCache)
@@ -38,59 +50,72 @@ void UsdBridgePrimCacheManager::InitializeWorldPrim(UsdBridgePrimCache* worldCac
 
 void UsdBridgePrimCacheManager::AddChild(UsdBridgePrimCache* parent, UsdBridgePrimCache* child)
 {
-  parent->Children.push_back(child);
+  parent->Children.Insert(child);
   child->IncRef();
 }
 
 void UsdBridgePrimCacheManager::RemoveChild(UsdBridgePrimCache* parent, UsdBridgePrimCache* child)
 {
-  auto it = std::find(parent->Children.begin(), parent->Children.end(), child);
-  // Allow for find to fail; in the case where the bridge is recreated and destroyed,
+  // Allow for erase to fail; in the case where the bridge is recreated and destroyed,
   // a child prim exists which doesn't have a ref in the cache.
-  if(it != parent->Children.end())
+  if(parent->Children.Erase(child))
   {
     child->DecRef();
-    *it = parent->Children.back();
-    parent->Children.pop_back();
+    if(child->RefCount == 0)
+      QueueForRemoval(child);
   }
 }
 
-void UsdBridgePrimCacheManager::RemoveUnreferencedChildTree(UsdBridgePrimCache* parent, AtRemoveFunc atRemove)
+void UsdBridgePrimCacheManager::QueueForRemoval(UsdBridgePrimCache* cache)
 {
-  assert(parent->RefCount == 0);
-  atRemove(parent);
-
-  for (UsdBridgePrimCache* child : parent->Children)
+  if(!cache->RemovalQueued)
   {
-    child->DecRef();
-    if(child->RefCount == 0)
-      RemoveUnreferencedChildTree(child, atRemove);
+    cache->RemovalQueued = true;
+    RemovalCandidates.push_back(cache);
   }
-  parent->Children.clear();
 }
 
-void UsdBridgePrimCacheManager::RemoveUnreferencedPrimCaches(AtRemoveFunc atRemove)
+bool UsdBridgePrimCacheManager::RemoveUnreferencedPrimCaches(AtRemoveFunc atRemove, double timeBudget)
 {
-  // First recursively remove all the child references for unreferenced prims
-  // Can only be performed at garbage collect.
+  // Only the candidates are visited, which are queued when created or when losing their last reference.
+  // Child references of unreferenced prims can only be released here, at garbage collect.
   // If this is done during RemoveChild, an unreferenced parent cannot subsequently be revived with an AddChild.
-  PrimCacheContainer::iterator it = UsdPrimCaches.begin();
-  while (it != UsdPrimCaches.end())
+  auto startTime = std::chrono::steady_clock::now();
+  while (!RemovalCandidates.empty())
   {
-    if (it->second->RefCount == 0)
+    UsdBridgePrimCache* candidate = RemovalCandidates.back();
+    RemovalCandidates.pop_back();
+
+    // Skip candidates that have been deleted in the meantime
+    auto indexIt = HandleIndex.find(candidate);
+    if (indexIt == HandleIndex.end())
+      continue;
+
+    candidate->RemovalQueued = false;
+    if (candidate->RefCount != 0)
+      continue;
+
+    atRemove(candidate);
+
+    UsdBridgeDenseSet<UsdBridgePrimCache*>& children = candidate->Children;
+    for (size_t childIdx = 0; childIdx < children.size(); ++childIdx)
     {
-      RemoveUnreferencedChildTree(it->second.get(), atRemove);
+      UsdBridgePrimCache* child = children[childIdx];
+      for (unsigned int refIdx = 0; refIdx < children.Count(childIdx); ++refIdx)
+        child->DecRef();
+      if(child->RefCount == 0)
+        QueueForRemoval(child);
     }
-    ++it;
-  }
+    candidate->Children.clear();
 
-  // Now delete all prims without references from the cache
-  it = UsdPrimCaches.begin();
-  while (it != UsdPrimCaches.end())
-  {
-    if (it->second->RefCount == 0)
-      it = UsdPrimCaches.erase(it);
-    else
-      ++it;
+    PrimCacheContainer::const_iterator cacheIt = UsdPrimCaches.find(*indexIt->second);
+    HandleIndex.erase(indexIt);
+    UsdPrimCaches.erase(cacheIt);
+
+    if (timeBudget > 0.0 &&
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count() > timeBudget)
+      break;
   }
-}
\ No newline at end of file
+
+  return RemovalCandidates.empty();
+}
@@ -5,11 +5,14 @@
 #define OmniBridgeCaches_h
 
 #include <string>
+#include <cstring>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
 #include "UsdBridgeData.h"
+#include "UsdBridgeUtils.h"
 #include "UsdBridgeUtils_Internal.h"
 
 struct UsdBridgePrimCache;
@@ -48,6 +51,85 @@ struct UsdBridgeResourceKey
 #endif
       ) : false ) : !rhs.name);
   }
+
+  struct Hash
+  {
+    size_t operator()(const UsdBridgeResourceKey& key) const
+    {
+      uint64_t hash = key.name ? UsdBridgeHashData(key.name, strlen(key.name)) : 0;
+#ifdef TIME_BASED_CACHING
+      hash = UsdBridgeHashCombine(hash, std::hash<double>()(key.timeStep));
+#endif
+      return static_cast<size_t>(hash);
+    }
+  };
+};
+
+// Counted set of elements stored in a dense vector, with an index map for constant time insertion, removal and lookup.
+// Iteration follows the dense vector: insertion order, except that a removed element is replaced by the last one.
+template<typename T, typename HashType = std::hash<T>>
+class UsdBridgeDenseSet
+{
+public:
+  typedef typename std::vector<T>::const_iterator const_iterator;
+
+  // Returns whether the element is new, otherwise its count is increased
+  bool Insert(const T& elt)
+  {
+    auto result = Indices.emplace(elt, Elements.size());
+    if(!result.second)
+    {
+      ++Counts[result.first->second];
+      return false;
+    }
+    Elements.push_back(elt);
+    Counts.push_back(1);
+    return true;
+  }
+
+  // Decreases the count of the element and removes it at zero. Returns whether the element was present.
+  bool Erase(const T& elt)
+  {
+    auto it = Indices.find(elt);
+    if(it == Indices.end())
+      return false;
+
+    size_t index = it->second;
+    if(--Counts[index] == 0)
+    {
+      Indices.erase(it);
+      if(index != Elements.size()-1)
+      {
+        Elements[index] = Elements.back();
+        Counts[index] = Counts.back();
+        Indices[Elements[index]] = index;
+      }
+      Elements.pop_back();
+      Counts.pop_back();
+    }
+    return true;
+  }
+
+  bool Contains(const T& elt) const { return Indices.find(elt) != Indices.end(); }
+
+  const T& operator[](size_t index) const { return Elements[index]; }
+  unsigned int Count(size_t index) const { return Counts[index]; }
+  size_t size() const { return Elements.size(); }
+  bool empty() const { return Elements.empty(); }
+  const_iterator begin() const { return Elements.begin(); }
+  const_iterator end() const { return Elements.end(); }
+
+  void clear()
+  {
+    Elements.clear();
+    Counts.clear();
+    Indices.clear();
+  }
+
+protected:
+  std::vector<T> Elements;
+  std::vector<unsigned int> Counts;
+  std::unordered_map<T, size_t, HashType> Indices;
 };
 
 struct UsdBridgeRefCache
@@ -60,7 +142,8 @@ protected:
   void DecRef() { --RefCount; }
 
   unsigned int RefCount = 0;
-  std::vector<UsdBridgePrimCache*> Children;
+  bool RemovalQueued = false;
+  UsdBridgeDenseSet<UsdBridgePrimCache*> Children; // Counted per reference to the child
 #ifdef TIME_BASED_CACHING
   //Could also contain a mapping from child to an array of (parentTime,childTime)
   //This would allow single timesteps to be removed in case of unused/replaced references at a parentTime (instead of removal of child if visible), without breaking garbage collection.
@@ -69,9 +152,52 @@ protected:
 #endif
 };
 
+// Mesh topology as authored to a layer, used to skip rewriting unchanged face vertex counts and indices
+struct UsdBridgeMeshTopology
+{
+  uint64_t NumFaces = 0;
+  uint64_t FaceVertexCount = 0;
+  uint64_t IndexHash = 0; // Zero for meshes without indices
+  bool Authored = false;
+
+  bool operator==(const UsdBridgeMeshTopology& other) const
+  {
+    return Authored && other.Authored && NumFaces == other.NumFaces && FaceVertexCount == other.FaceVertexCount && IndexHash == other.IndexHash;
+  }
+};
+
+struct UsdBridgeMeshTopologyCache
+{
+  UsdBridgeMeshTopology Uniform; // Time-uniform value of the prim in the scene stage
+  UsdBridgeMeshTopology Shared; // Default value of the prim in the manifest, used by clip stages without topology of their own
+};
+
+// Arrays of a point instancer as last written, along with the source transform of each element
+struct UsdBridgeInstancerArrays
+{
+  std::vector<float> Transforms; // 16 floats per instance
+  VtIntArray ProtoIndices;
+  VtVec3fArray Positions;
+  VtQuathArray Orientations;
+  VtVec3fArray Scales;
+};
+
+#ifdef VALUE_CLIP_RETIMING
+// Value clip metadata of a referencing prim, kept per parent timestep and authored as arrays by UsdBridgeUsdWriter::FlushClipMetaData
+struct UsdBridgeClipMetaData
+{
+  std::map<double, double> ClipTimes; // Parent timestep to child timestep
+  std::map<double, int> ClipActives; // Parent timestep to index in AssetPaths
+  VtArray<SdfAssetPath> AssetPaths;
+  std::unordered_map<std::string, int> AssetIndices; // Inverse of AssetPaths
+  std::vector<int> AssetUseCounts; // Amount of ClipActives entries per index in AssetPaths
+  bool Modified = false;
+};
+#endif
+
 struct UsdBridgePrimCache : public UsdBridgeRefCache
 {
-  using ResourceContainer = std::vector<UsdBridgeResourceKey>;
+  using ResourceContainer = UsdBridgeDenseSet<UsdBridgeResourceKey, UsdBridgeResourceKey::Hash>;
 
   //Constructors
   UsdBridgePrimCache(const SdfPath& pp, const SdfPath& nm, ResourceCollectFunc cf)
@@ -90,14 +216,21 @@ struct UsdBridgePrimCache : public UsdBridgeRefCache
   SdfPath Name;
   ResourceCollectFunc ResourceCollect;
   std::unique_ptr<ResourceContainer> ResourceKeys; // Referenced resources
+  UsdBridgePrimCache* GeomPrototype = nullptr; // Shared prototype holding the data of a deduplicated geometry (also one of its Children)
+  uint64_t GeomContentKey = 0; // Second content hash of a geometry prototype, verifying matches of the hash in its name
+  UsdBridgePrimCache* GeomLod = nullptr; // Reduced-resolution levels of a mesh geometry (also one of its Children)
+  uint32_t GeomChunkCount = 0; // Amount of spatial chunk prims below a geometry prim, which has no data of its own if nonzero
+  std::unordered_map<SdfPath, UsdBridgeMeshTopologyCache, SdfPath::Hash> MeshTopologies; // Per mesh prim of a geometry (itself or its chunks)
+  UsdGeomXformOp TransformOp; // Transform op of an instance, created at its first transform update
+  UsdBridgePrimCacheList InstancerInstances; // Instances of a world that are written as point instancers (also its Children)
+  std::unordered_map<SdfPath, UsdBridgeInstancerArrays, SdfPath::Hash> InstancerArrays; // Per point instancer of a world
 
   bool AddResourceKey(UsdBridgeResourceKey key) // copy by value
   {
     assert(ResourceKeys);
-    bool newEntry = std::find(ResourceKeys->begin(), ResourceKeys->end(), key) == ResourceKeys->end();
-    if(newEntry)
-      ResourceKeys->push_back(key);
-    return newEntry;
+    if(ResourceKeys->Contains(key))
+      return false;
+    return ResourceKeys->Insert(key);
   }
 
 #ifdef VALUE_CLIP_RETIMING
@@ -106,6 +239,9 @@ struct UsdBridgePrimCache : public UsdBridgeRefCache
 
   uint32_t LastTimeVaryingBits = 0; // Used to detect changes in timevarying status of parameters
 
+  std::unordered_map<SdfPath, UsdBridgeClipMetaData, SdfPath::Hash> ClipMetaData; // Per referencing prim with value clips below this prim
+  bool ClipMetaDataModified = false; // Queued in UsdBridgeUsdWriter::ModifiedClipMetaData
+
   static constexpr double PrimStageTimeCode = 0.0; // Prim stages are stored in ClipStages under specified time code
   const UsdStagePair& GetPrimStagePair() const
   {
@@ -151,18 +287,25 @@ public:
   inline bool ValidIterator(ConstPrimCacheIterator it) const { return it != UsdPrimCaches.end(); }
 
   ConstPrimCacheIterator CreatePrimCache(const std::string& name, const std::string& fullPath, ResourceCollectFunc collectFunc = nullptr);
-  void RemovePrimCache(ConstPrimCacheIterator it) { UsdPrimCaches.erase(it); }
+  void RemovePrimCache(ConstPrimCacheIterator it);
 
   void InitializeWorldPrim(UsdBridgePrimCache* worldCache);
 
   void AddChild(UsdBridgePrimCache* parent, UsdBridgePrimCache* child);
   void RemoveChild(UsdBridgePrimCache* parent, UsdBridgePrimCache* child);
-  void RemoveUnreferencedChildTree(UsdBridgePrimCache* parent, AtRemoveFunc atRemove);
-  void RemoveUnreferencedPrimCaches(AtRemoveFunc atRemove);
+  // Removes the unreferenced prim caches and releases their references to children, until no removal candidates are left
+  // or timeBudget (in milliseconds, 0 is unlimited) has been exceeded. Returns whether all candidates have been processed.
+  bool RemoveUnreferencedPrimCaches(AtRemoveFunc atRemove, double timeBudget = 0.0);
 
 protected:
+  void QueueForRemoval(UsdBridgePrimCache* cache);
+
+  // Map keys are node-based and stay valid until their entry is erased, unlike iterators across a rehash
+  typedef std::unordered_map<const UsdBridgePrimCache*, const std::string*> PrimCacheHandleIndex;
 
   PrimCacheContainer UsdPrimCaches;
+  PrimCacheHandleIndex HandleIndex; // Lookup of UsdPrimCaches entries by handle, kept in sync with UsdPrimCaches
+  UsdBridgePrimCacheList RemovalCandidates; // Caches created or dereferenced since they were last considered for removal
 };
 
 #endif
\ No newline at end of file
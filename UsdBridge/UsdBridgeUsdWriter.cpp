@@ -37,6 +37,7 @@ namespace constring
   const char* const psSamplerPrimPf = "pssampler";
   const char* const mdlSamplerPrimPf = "mdlsampler";
   const char* const openVDBPrimPf = "ovdbfield";
+  const char* const geomChunkPrimPf = "chunk";
 
   const char* const imageExtension = ".png";
   const char* const vdbExtension = ".vdb";
@@ -265,7 +266,7 @@ UsdStageRefPtr UsdBridgeUsdWriter::GetTimeVarStage(UsdBridgePrimCache* cache
   , bool useClipStage, const char* clipPf, double timeStep
   , std::function<void (UsdStageRefPtr)> initFunc
 #endif
-  ) const
+  )
 {
 #ifdef VALUE_CLIP_RETIMING
 #ifdef TIME_CLIP_STAGES
@@ -320,22 +321,26 @@ void UsdBridgeUsdWriter::RemoveManifestAndClipStages(const UsdBridgePrimCache* c
   // remove all clipstage files
   for (auto& x : cacheEntry->ClipStages)
   {
+#ifdef TIME_CLIP_STAGES
+    UnsavedClipLayers.erase(x.second.second->GetRootLayer());
+    TimeStepClipStages.erase(get_pointer(x.second.second));
+#endif
     Connect->RemoveFile((SessionDirectory + x.second.first).c_str(), true);
   }
 }
 
-const UsdStagePair& UsdBridgeUsdWriter::FindOrCreatePrimStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix) const
+const UsdStagePair& UsdBridgeUsdWriter::FindOrCreatePrimStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix)
 {
   bool exists;
   return FindOrCreatePrimClipStage(cacheEntry, namePostfix, false, UsdBridgePrimCache::PrimStageTimeCode, exists);
 }
 
-const UsdStagePair& UsdBridgeUsdWriter::FindOrCreateClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, double timeStep, bool& exists) const
+const UsdStagePair& UsdBridgeUsdWriter::FindOrCreateClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, double timeStep, bool& exists)
 {
   return FindOrCreatePrimClipStage(cacheEntry, namePostfix, true, timeStep, exists);
 }
 
-const UsdStagePair& UsdBridgeUsdWriter::FindOrCreatePrimClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, bool isClip, double timeStep, bool& exists) const
+const UsdStagePair& UsdBridgeUsdWriter::FindOrCreatePrimClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, bool isClip, double timeStep, bool& exists)
 {
   exists = true;
   bool binary = this->Settings.BinaryOutput;
@@ -354,24 +359,72 @@ const UsdStagePair& UsdBridgeUsdWriter::FindOrCreatePrimClipStage(UsdBridgePrimC
     std::string relativeFileName = folder + cacheEntry->Name.GetString() + fullNamePostfix + (binary ? ".usd" : ".usda");
     std::string absoluteFileName = Connect->GetUrl((this->SessionDirectory + relativeFileName).c_str());
 
-    UsdStageRefPtr primClipStage = UsdStage::CreateNew(absoluteFileName);
-    exists = !primClipStage;
-
-    SdfPath rootPrimPath(this->RootClassName);
-    if (exists)
+    UsdStageRefPtr primClipStage;
+#ifdef TIME_CLIP_STAGES
+    if(isClip)
     {
-      primClipStage = UsdStage::Open(absoluteFileName); //Could happen if written folder is reused 
-      assert(primClipStage->GetPrimAtPath(rootPrimPath));
+      // Clip stages start out as in-memory layers under their final identifier, so clip asset paths resolve to them
+      // before they are written. The file is only created by SaveClipStages(), without a separate stage open per clip.
+      // A layer may still be in use, eg. by value clip resolution for a removed prim of the same name.
+      SdfLayerRefPtr clipLayer = SdfLayer::Find(absoluteFileName);
+      if(!clipLayer && !this->Settings.CreateNewSession)
+        clipLayer = SdfLayer::FindOrOpen(absoluteFileName); //Could happen if written folder is reused
+      exists = bool(clipLayer);
+      if(!exists)
+        clipLayer = SdfLayer::New(SdfFileFormat::FindByExtension(absoluteFileName), absoluteFileName);
+
+      if(clipLayer)
+        primClipStage = UsdStage::Open(clipLayer, SdfLayerHandle(), UsdStage::LoadNone); // No session layer
     }
-    else
+    if(!primClipStage)
+#endif
+    {
+      primClipStage = UsdStage::CreateNew(absoluteFileName);
+      exists = !primClipStage;
+      if (exists)
+        primClipStage = UsdStage::Open(absoluteFileName); //Could happen if written folder is reused 
+    }
+    if(!primClipStage)
+    {
+      UsdBridgeLogMacro(this, UsdBridgeLogLevel::ERR, "Stage " << absoluteFileName << " cannot be created or opened, its data is kept in memory only.");
+      primClipStage = UsdStage::CreateInMemory();
+      exists = false;
+    }
+
+    SdfPath rootPrimPath(this->RootClassName);
+    if (!exists || !primClipStage->GetPrimAtPath(rootPrimPath))
       primClipStage->DefinePrim(rootPrimPath);
 
     it = cacheEntry->ClipStages.emplace(timeStep, UsdStagePair(std::move(relativeFileName), primClipStage)).first;
+#ifdef TIME_CLIP_STAGES
+    if(isClip)
+      TimeStepClipStages.insert(get_pointer(primClipStage));
+#endif
   }
+
+#ifdef TIME_CLIP_STAGES
+  // Any stage handed out may be written to, saving a layer without changes is a no-op
+  if(isClip && this->EnableSaving)
+    UnsavedClipLayers.insert(it->second.second->GetRootLayer());
+#endif
+
   return it->second;
 }
 #endif
 
+#ifdef TIME_CLIP_STAGES
+void UsdBridgeUsdWriter::SaveClipStages()
+{
+  for (const SdfLayerHandle& clipLayer : UnsavedClipLayers)
+  {
+    // Clip stages may have been released without notice, and in-memory fallback stages have no file
+    if (clipLayer && !clipLayer->IsAnonymous())
+      clipLayer->Save();
+  }
+  UnsavedClipLayers.clear();
+}
+#endif
+
 void UsdBridgeUsdWriter::SetSceneGraphRoot(UsdBridgePrimCache* worldCache, const char* name)
 {
   // Also add concrete scenegraph prim with reference to world class
@@ -430,15 +483,40 @@ bool UsdBridgeUsdWriter::CreatePrim(const SdfPath& path)
   return false;
 }
 
+namespace
+{
+  template<typename RecordMap>
+  void EraseTimeSampleRecords(RecordMap& records, const SdfPath& primPath)
+  {
+    // Records of the prim's attributes and descendants directly follow the prim path in path order
+    auto beginIt = records.lower_bound(typename RecordMap::key_type(primPath, nullptr));
+    auto endIt = beginIt;
+    while (endIt != records.end() && endIt->first.first.HasPrefix(primPath))
+      ++endIt;
+    records.erase(beginIt, endIt);
+  }
+}
+
 void UsdBridgeUsdWriter::DeletePrim(const UsdBridgePrimCache* cacheEntry)
 {
   SceneStage->RemovePrim(cacheEntry->PrimPath);
 
+  // A prim recreated at the same path should not be compared against the samples of the removed one
+  EraseTimeSampleRecords(TimeSampleRecords, cacheEntry->PrimPath);
+  EraseTimeSampleRecords(KeyframeRecords, cacheEntry->PrimPath);
+
+  for (auto fullIt = FullPrecisionAttributes.lower_bound(cacheEntry->PrimPath);
+    fullIt != FullPrecisionAttributes.end() && fullIt->HasPrefix(cacheEntry->PrimPath);)
+    fullIt = FullPrecisionAttributes.erase(fullIt);
+
 #ifdef VALUE_CLIP_RETIMING
   if (cacheEntry->ManifestStage.second)
   {
     RemoveManifestAndClipStages(cacheEntry);
   }
+
+  if (cacheEntry->ClipMetaDataModified)
+    ModifiedClipMetaData.erase(std::remove(ModifiedClipMetaData.begin(), ModifiedClipMetaData.end(), cacheEntry), ModifiedClipMetaData.end());
 #endif
 }
 
@@ -551,7 +629,7 @@ void UsdBridgeUsdWriter::ChildrenRemoveIfVisible(UsdStageRefPtr stage, UsdBridge
 
 
 #ifdef VALUE_CLIP_RETIMING
-void UsdBridgeUsdWriter::InitializeClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix)
+void UsdBridgeUsdWriter::InitializeClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* parentCache, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix)
 {
   UsdClipsAPI clipsApi(clipPrim);
 
@@ -580,23 +658,74 @@ void UsdBridgeUsdWriter::InitializeClipMetaData(const UsdPrim& clipPrim, UsdBrid
 
   clipsApi.SetClipManifestAssetPath(SdfAssetPath(manifestPath));
 
-  VtArray<SdfAssetPath> assetPaths;
-  assetPaths.push_back(SdfAssetPath(*refStagePath));
-  clipsApi.SetClipAssetPaths(assetPaths);
+  // The clip arrays are authored at the next flush
+  UsdBridgeClipMetaData& clipMetaData = parentCache->ClipMetaData[clipPrim.GetPath()];
+  clipMetaData = UsdBridgeClipMetaData();
+  clipMetaData.AssetPaths.push_back(SdfAssetPath(*refStagePath));
+  clipMetaData.AssetIndices[*refStagePath] = 0;
+  clipMetaData.AssetUseCounts.push_back(1);
+  clipMetaData.ClipActives[parentTimeStep] = 0;
+  clipMetaData.ClipTimes[parentTimeStep] = childTimeStep;
+
+  clipMetaData.Modified = true;
+  if (!parentCache->ClipMetaDataModified)
+  {
+    parentCache->ClipMetaDataModified = true;
+    ModifiedClipMetaData.push_back(parentCache);
+  }
+}
+
+UsdBridgeClipMetaData& UsdBridgeUsdWriter::GetClipMetaData(UsdBridgePrimCache* parentCache, const UsdPrim& clipPrim)
+{
+  auto insertResult = parentCache->ClipMetaData.emplace(clipPrim.GetPath(), UsdBridgeClipMetaData());
+  UsdBridgeClipMetaData& clipMetaData = insertResult.first->second;
+
+  // Clip prims of a reopened session are read from the stage once
+  if (insertResult.second)
+  {
+    UsdClipsAPI clipsApi(clipPrim);
+
+    VtVec2dArray clipActives, clipTimes;
+    clipsApi.GetClipActive(&clipActives);
+    clipsApi.GetClipAssetPaths(&clipMetaData.AssetPaths);
+    clipsApi.GetClipTimes(&clipTimes);
+
+    clipMetaData.AssetUseCounts.resize(clipMetaData.AssetPaths.size(), 0);
+    for (size_t i = 0; i < clipMetaData.AssetPaths.size(); ++i)
+      clipMetaData.AssetIndices.emplace(clipMetaData.AssetPaths[i].GetAssetPath(), int(i));
+    for (const GfVec2d& clipActive : clipActives)
+    {
+      int assetIndex = int(clipActive[1]);
+      if (assetIndex >= 0 && assetIndex < int(clipMetaData.AssetUseCounts.size()))
+      {
+        clipMetaData.ClipActives[clipActive[0]] = assetIndex;
+        ++clipMetaData.AssetUseCounts[assetIndex];
+      }
+    }
+    for (const GfVec2d& clipTime : clipTimes)
+      clipMetaData.ClipTimes[clipTime[0]] = clipTime[1];
+  }
 
-  VtVec2dArray clipActives;
-  clipActives.push_back(GfVec2d(parentTimeStep, 0));
-  clipsApi.SetClipActive(clipActives);
+  return clipMetaData;
+}
 
-  VtVec2dArray clipTimes;
-  clipTimes.push_back(GfVec2d(parentTimeStep, childTimeStep));
-  clipsApi.SetClipTimes(clipTimes);
+bool UsdBridgeUsdWriter::HasClipMetaData(const UsdBridgePrimCache* parentCache, const UsdPrim& clipPrim) const
+{
+  return parentCache->ClipMetaData.count(clipPrim.GetPath()) || clipPrim.HasAuthoredMetadata(UsdTokens->clips);
 }
 
-void UsdBridgeUsdWriter::UpdateClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix)
+void UsdBridgeUsdWriter::ClearClipMetaData(UsdBridgePrimCache* parentCache, const UsdPrim& clipPrim)
+{
+  // A queued flush of the entry skips it once erased
+  parentCache->ClipMetaData.erase(clipPrim.GetPath());
+  if (clipPrim.HasAuthoredMetadata(UsdTokens->clips))
+    clipPrim.ClearMetadata(UsdTokens->clips);
+}
+
+void UsdBridgeUsdWriter::UpdateClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* parentCache, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix)
 {
   // Add parent-child timestep or update existing relationship
-  UsdClipsAPI clipsApi(clipPrim);
+  UsdBridgeClipMetaData& clipMetaData = GetClipMetaData(parentCache, clipPrim);
 
 #ifdef TIME_CLIP_STAGES
   if (clipStages)
@@ -608,80 +737,101 @@ void UsdBridgeUsdWriter::UpdateClipMetaData(const UsdPrim& clipPrim, UsdBridgePr
 
     const std::string& refStagePath = childStagePair.first;
 
-    VtVec2dArray clipActives;
-    clipsApi.GetClipActive(&clipActives);
-    VtArray<SdfAssetPath> assetPaths;
-    clipsApi.GetClipAssetPaths(&assetPaths);
-
     // Find the asset path
-    SdfAssetPath refStageSdf(refStagePath);
-    auto assetIt = std::find_if(assetPaths.begin(), assetPaths.end(), [&refStageSdf](const SdfAssetPath& entry) -> bool { return refStageSdf.GetAssetPath() == entry.GetAssetPath(); });
-    int assetIndex = int(assetIt - assetPaths.begin());
-    bool newAsset = (assetIndex == assetPaths.size()); // Gives the opportunity to garbage collect unused asset references
+    auto assetIt = clipMetaData.AssetIndices.find(refStagePath);
+    bool newAsset = (assetIt == clipMetaData.AssetIndices.end()); // Gives the opportunity to garbage collect unused asset references
+    int assetIndex = newAsset ? int(clipMetaData.AssetPaths.size()) : assetIt->second;
 
+    auto activeIt = clipMetaData.ClipActives.find(parentTimeStep);
+    if (activeIt != clipMetaData.ClipActives.end())
     {
-      // Find the parentTimeStep
-      int timeFindIdx = 0;
-      for (; timeFindIdx < clipActives.size() && clipActives[timeFindIdx][0] != parentTimeStep; ++timeFindIdx)
-      {}
-
-      bool replaceAsset = false;
-
-      // If timestep not found, just add (time, asset ref idx) to actives
-      if (timeFindIdx == clipActives.size())
-        clipActives.push_back(GfVec2d(parentTimeStep, assetIndex));
-      else
+      // Update the existing active entry with the new asset ref idx, or, if its asset isn't referenced by any other entry,
+      // leave the entry unchanged and replace the asset itself
+      int prevAssetIndex = activeIt->second;
+      if (newAsset && clipMetaData.AssetUseCounts[prevAssetIndex] == 1)
       {
-        // Find out whether to update existing active entry with new asset ref idx, or let the entry unchanged and replace the asset itself
-        double prevAssetIndex = clipActives[timeFindIdx][1];
-       
-        if (newAsset)
-        {
-          //Find prev asset index
-          int assetIdxFindIdx = 0;
-          for (; assetIdxFindIdx < clipActives.size() && 
-            (assetIdxFindIdx == timeFindIdx || clipActives[assetIdxFindIdx][1] != prevAssetIndex); 
-            ++assetIdxFindIdx)
-          {}
-
-          // replacement occurs when prevAssetIndex hasn't been found in other entries
-          replaceAsset = (assetIdxFindIdx == clipActives.size());
-        }
-
-        if(replaceAsset)
-          assetPaths[int(prevAssetIndex)] = refStageSdf;
-        else
-          clipActives[timeFindIdx][1] = assetIndex;
+        clipMetaData.AssetIndices.erase(clipMetaData.AssetPaths[prevAssetIndex].GetAssetPath());
+        clipMetaData.AssetPaths[prevAssetIndex] = SdfAssetPath(refStagePath);
+        clipMetaData.AssetIndices[refStagePath] = prevAssetIndex;
+        newAsset = false;
+        assetIndex = prevAssetIndex;
       }
+      else if (prevAssetIndex != assetIndex)
+        --clipMetaData.AssetUseCounts[prevAssetIndex];
+    }
 
-      // If new asset and not put in place of an old asset, add to assetPaths
-      if (newAsset && !replaceAsset)
-        assetPaths.push_back(refStageSdf);
+    // If new asset and not put in place of an old asset, add to assetPaths
+    if (newAsset)
+    {
+      clipMetaData.AssetPaths.push_back(SdfAssetPath(refStagePath));
+      clipMetaData.AssetIndices[refStagePath] = assetIndex;
+      clipMetaData.AssetUseCounts.push_back(0);
+    }
 
-      // Send the result through to usd
-      clipsApi.SetClipAssetPaths(assetPaths);
-      clipsApi.SetClipActive(clipActives);
+    // Add or update the (time, asset ref idx) entry in actives
+    int& activeAssetIndex = clipMetaData.ClipActives[parentTimeStep];
+    if (activeIt == clipMetaData.ClipActives.end() || activeAssetIndex != assetIndex)
+    {
+      activeAssetIndex = assetIndex;
+      ++clipMetaData.AssetUseCounts[assetIndex];
     }
   }
 #endif
 
-  // Find the parentTimeStep, and change its child (or add the pair if nonexistent)
-  VtVec2dArray clipTimes;
-  clipsApi.GetClipTimes(&clipTimes);
+  // Change the child timestep of parentTimeStep (or add the pair if nonexistent)
+  clipMetaData.ClipTimes[parentTimeStep] = childTimeStep;
+
+  clipMetaData.Modified = true;
+  if (!parentCache->ClipMetaDataModified)
   {
-    int findIdx = 0;
-    for (; findIdx < clipTimes.size(); ++findIdx)
+    parentCache->ClipMetaDataModified = true;
+    ModifiedClipMetaData.push_back(parentCache);
+  }
+}
+
+void UsdBridgeUsdWriter::FlushClipMetaData()
+{
+  for (UsdBridgePrimCache* parentCache : ModifiedClipMetaData)
+  {
+    parentCache->ClipMetaDataModified = false;
+
+    for (auto clipIt = parentCache->ClipMetaData.begin(); clipIt != parentCache->ClipMetaData.end();)
     {
-      if (clipTimes[findIdx][0] == parentTimeStep)
+      UsdBridgeClipMetaData& clipMetaData = clipIt->second;
+      if (!clipMetaData.Modified)
       {
-        clipTimes[findIdx][1] = childTimeStep;
-        break;
+        ++clipIt;
+        continue;
       }
+
+      // Referencing prims may have been removed since their last update
+      UsdPrim clipPrim = SceneStage->GetPrimAtPath(clipIt->first);
+      if (!clipPrim)
+      {
+        clipIt = parentCache->ClipMetaData.erase(clipIt);
+        continue;
+      }
+
+      VtVec2dArray clipActives;
+      clipActives.reserve(clipMetaData.ClipActives.size());
+      for (const auto& clipActive : clipMetaData.ClipActives)
+        clipActives.push_back(GfVec2d(clipActive.first, clipActive.second));
+
+      VtVec2dArray clipTimes;
+      clipTimes.reserve(clipMetaData.ClipTimes.size());
+      for (const auto& clipTime : clipMetaData.ClipTimes)
+        clipTimes.push_back(GfVec2d(clipTime.first, clipTime.second));
+
+      UsdClipsAPI clipsApi(clipPrim);
+      clipsApi.SetClipAssetPaths(clipMetaData.AssetPaths);
+      clipsApi.SetClipActive(clipActives);
+      clipsApi.SetClipTimes(clipTimes);
+
+      clipMetaData.Modified = false;
+      ++clipIt;
     }
-    if (findIdx == clipTimes.size())
-      clipTimes.push_back(GfVec2d(parentTimeStep, childTimeStep));
-    clipsApi.SetClipTimes(clipTimes);
   }
+  ModifiedClipMetaData.clear();
 }
 
 #endif
@@ -725,7 +875,7 @@ SdfPath UsdBridgeUsdWriter::AddRef_Impl(UsdBridgePrimCache* parentCache, UsdBrid
 
 #ifdef VALUE_CLIP_RETIMING
     if (valueClip)
-      InitializeClipMetaData(referencingPrim, childCache, parentTimeStep, childTimeStep, clipStages, clipPostfix);
+      InitializeClipMetaData(referencingPrim, parentCache, childCache, parentTimeStep, childTimeStep, clipStages, clipPostfix);
 #endif
 
     {
@@ -752,8 +902,13 @@ SdfPath UsdBridgeUsdWriter::AddRef_Impl(UsdBridgePrimCache* parentCache, UsdBrid
 #ifdef VALUE_CLIP_RETIMING
     // Cliptimes are added as additional info, not actively removed (visibility values remain leading in defining existing relationships over timesteps)
     // Also, clip stages at childTimeSteps which are not referenced anymore, are not removed; they could still be referenced from other parents!
-    if (valueClip)
-      UpdateClipMetaData(referencingPrim, childCache, parentTimeStep, childTimeStep, clipStages, clipPostfix);
+    // A reference can switch between retimed and plain, eg. when its child becomes deduplicated geometry.
+    if (valueClip && HasClipMetaData(parentCache, referencingPrim))
+      UpdateClipMetaData(referencingPrim, parentCache, childCache, parentTimeStep, childTimeStep, clipStages, clipPostfix);
+    else if (valueClip)
+      InitializeClipMetaData(referencingPrim, parentCache, childCache, parentTimeStep, childTimeStep, clipStages, clipPostfix);
+    else
+      ClearClipMetaData(parentCache, referencingPrim);
 #endif
 #endif
   }
@@ -813,17 +968,18 @@ void UsdBridgeUsdWriter::ManageUnusedRefs(UsdStageRefPtr stage, UsdBridgePrimCac
 
   if (basePrim)
   {
+    // Tokens compare and hash by pointer, so the diff takes a single pass over old and new children
+    TfToken::HashSet newChildNames;
+    newChildNames.reserve(newChildren.size());
+    for (const UsdBridgePrimCache* newChild : newChildren)
+      newChildNames.insert(newChild->Name.GetNameToken());
+
     UsdPrimSiblingRange children = basePrim.GetAllChildren();
     for (UsdPrim oldChild : children)
     {
-      const std::string& oldChildName = oldChild.GetPrimPath().GetName();
+      const TfToken& oldChildName = oldChild.GetName();
 
-      bool found = false;
-      for (size_t newChildIdx = 0; newChildIdx < newChildren.size() && !found; ++newChildIdx)
-      {
-        const std::string& newChildName = newChildren[newChildIdx]->Name.GetString();
-        found = (newChildName == oldChildName);
-      }
+      bool found = (newChildNames.find(oldChildName) != newChildNames.end());
 
       if (!found)
 #ifdef TIME_BASED_CACHING
@@ -838,7 +994,7 @@ void UsdBridgeUsdWriter::ManageUnusedRefs(UsdStageRefPtr stage, UsdBridgePrimCac
       }
 #else
       {// remove the whole referencing prim
-        atRemoveRef(parentCache, oldChildName);
+        atRemoveRef(parentCache, oldChildName.GetString());
         stage->RemovePrim(oldChild.GetPath());
       }
 #endif
@@ -873,7 +1029,225 @@ void UsdBridgeUsdWriter::UnbindMaterialFromGeom(const SdfPath & refGeomPath)
   UsdShadeMaterialBindingAPI(refGeomPrim).UnbindDirectBinding();
 }
 
-void UsdBridgeUsdWriter::UpdateUsdTransform(const SdfPath& transPrimPath, float* transform, bool timeVarying, double timeStep)
+void UsdBridgeUsdWriter::SetGeometryPrototypeRef(const UsdBridgePrimCache* geomCache, const UsdBridgePrimCache* protoCache)
+{
+  UsdPrim geomPrim = this->SceneStage->GetPrimAtPath(geomCache->PrimPath);
+  assert(geomPrim);
+
+  UsdReferences references = geomPrim.GetReferences();
+  references.ClearReferences();
+
+  if (protoCache)
+  {
+    // Values (and interpolation) written to the geometry prim itself are stronger than the prototype's, so clear them out.
+    // The attribute specs remain, so the manifest and prim layout stay the same as for a non-deduplicated geometry.
+    for (UsdAttribute attrib : geomPrim.GetAuthoredAttributes())
+    {
+      attrib.Clear();
+      attrib.ClearMetadata(UsdGeomTokens->interpolation);
+      attrib.ClearMetadata(UsdGeomTokens->elementSize);
+    }
+
+    references.AddInternalReference(protoCache->PrimPath);
+  }
+}
+
+bool UsdBridgeUsdWriter::SkipRedundantTimeSample(const UsdAttribute& attrib, uint64_t valueHash, const UsdTimeCode& timeCode)
+{
+#ifdef TIME_BASED_CACHING
+  if (timeCode.IsDefault())
+    return false;
+
+  double timeStep = timeCode.GetValue();
+  const UsdStage* stage = get_pointer(attrib.GetStage());
+#ifdef TIME_CLIP_STAGES
+  if (TimeStepClipStages.count(stage))
+    return false;
+#endif
+
+  TimeSampleKey key(attrib.GetPath(), stage);
+
+  auto recordIt = TimeSampleRecords.find(key);
+  if (recordIt == TimeSampleRecords.end())
+  {
+    TimeSampleRecord& record = TimeSampleRecords[key];
+    record.AuthoredTime = timeStep;
+    record.ValueHash = valueHash;
+    return false;
+  }
+
+  TimeSampleRecord& record = recordIt->second;
+  double lastTime = record.SkippedTimes.empty() ? record.AuthoredTime : record.SkippedTimes.back();
+
+  // The record is only valid as long as its sample hasn't been cleared
+  bool recordValid = HasTimeSampleAt(attrib, record.AuthoredTime);
+  if (recordValid && valueHash == record.ValueHash)
+  {
+    if (timeStep > lastTime)
+    {
+      record.SkippedTimes.push_back(timeStep);
+      return true;
+    }
+    if (timeStep == record.AuthoredTime)
+      return true;
+  }
+
+  if (recordValid && !record.SkippedTimes.empty())
+  {
+    // Author the held value where interpolation towards the new sample would otherwise change it.
+    // Timesteps written out of order require all skipped samples.
+    VtValue heldValue;
+    attrib.Get(&heldValue, record.AuthoredTime);
+    if (timeStep > lastTime)
+      attrib.Set(heldValue, lastTime);
+    else
+    {
+      for (double skippedTime : record.SkippedTimes)
+      {
+        if (skippedTime != timeStep)
+          attrib.Set(heldValue, skippedTime);
+      }
+    }
+  }
+
+  if (timeStep >= lastTime)
+  {
+    record.AuthoredTime = timeStep;
+    record.ValueHash = valueHash;
+    record.SkippedTimes.clear();
+  }
+  else
+    TimeSampleRecords.erase(recordIt);
+#endif
+  return false;
+}
+
+#ifdef TIME_BASED_CACHING
+namespace
+{
+  // Bounds the amount of dropped samples that every subsequent sample is checked against, and the memory kept per attribute
+  constexpr size_t MaxDroppedKeyframeSamples = 16;
+
+  // Components of the values that are interpolated linearly (componentwise) between timesamples
+  bool GetInterpolatedComponents(const VtValue& value, std::vector<double>& components)
+  {
+    if (value.IsHolding<float>())
+      components.assign(1, value.UncheckedGet<float>());
+    else if (value.IsHolding<double>())
+      components.assign(1, value.UncheckedGet<double>());
+    else if (value.IsHolding<GfVec3f>())
+    {
+      const GfVec3f& vec = value.UncheckedGet<GfVec3f>();
+      components.assign(vec.data(), vec.data() + 3);
+    }
+    else if (value.IsHolding<GfVec4f>())
+    {
+      const GfVec4f& vec = value.UncheckedGet<GfVec4f>();
+      components.assign(vec.data(), vec.data() + 4);
+    }
+    else if (value.IsHolding<GfMatrix4d>())
+    {
+      const GfMatrix4d& mat = value.UncheckedGet<GfMatrix4d>();
+      components.assign(mat.data(), mat.data() + 16);
+    }
+    else
+      return false;
+    return true;
+  }
+
+  bool WithinInterpolationTolerance(double startTime, const std::vector<double>& start, double endTime, const std::vector<double>& end,
+    double time, const double* sample, double tolerance)
+  {
+    double alpha = (time - startTime) / (endTime - startTime);
+    for (size_t i = 0; i < start.size(); ++i)
+    {
+      if (std::abs(start[i] + alpha*(end[i] - start[i]) - sample[i]) > tolerance)
+        return false;
+    }
+    return true;
+  }
+}
+#endif
+
+bool UsdBridgeUsdWriter::ReduceTimeSampleValue(const UsdAttribute& attrib, const VtValue& value, const UsdTimeCode& timeCode)
+{
+#ifdef TIME_BASED_CACHING
+  KeyframeSample sample;
+  if (!GetInterpolatedComponents(value, sample.Components))
+    return false;
+  sample.Time = timeCode.GetValue();
+
+  TimeSampleKey key(attrib.GetPath(), get_pointer(attrib.GetStage()));
+  auto recordIt = KeyframeRecords.find(key);
+
+  // Start with a keyframe if there is no record, or if the record's keyframe has been cleared from the attribute
+  if (recordIt == KeyframeRecords.end() || !HasTimeSampleAt(attrib, recordIt->second.Keyframe.Time))
+  {
+    attrib.Set(value, timeCode);
+
+    KeyframeRecord& record = KeyframeRecords[key];
+    record.Keyframe = sample;
+    record.LastSample = std::move(sample);
+    record.DroppedTimes.clear();
+    record.DroppedComponents.clear();
+    return true;
+  }
+
+  KeyframeRecord& record = recordIt->second;
+  if (sample.Time <= record.LastSample.Time)
+  {
+    // Out of order samples change the interpolation between the keyframe and the last sample, so the dropped samples are
+    // authored after all, with their interpolated values (within tolerance of the dropped ones)
+    for (double droppedTime : record.DroppedTimes)
+    {
+      VtValue droppedValue;
+      attrib.Get(&droppedValue, droppedTime);
+      attrib.Set(droppedValue, droppedTime);
+    }
+    attrib.Set(value, timeCode);
+
+    KeyframeRecords.erase(recordIt);
+    return true;
+  }
+
+  // The last sample is dropped if it, and all samples dropped before it, are within tolerance of the interpolation
+  // between the keyframe and the new sample. Otherwise it stays authored and becomes the next keyframe.
+  const KeyframeSample& keyframe = record.Keyframe;
+  double tolerance = Settings.TimeCompressionTolerance;
+  size_t numComponents = keyframe.Components.size();
+  bool dropLastSample = record.LastSample.Time != keyframe.Time
+    && record.DroppedTimes.size() < MaxDroppedKeyframeSamples
+    && sample.Components.size() == numComponents
+    && WithinInterpolationTolerance(keyframe.Time, keyframe.Components, sample.Time, sample.Components,
+      record.LastSample.Time, record.LastSample.Components.data(), tolerance);
+  for (size_t i = 0; dropLastSample && i < record.DroppedTimes.size(); ++i)
+  {
+    dropLastSample = WithinInterpolationTolerance(keyframe.Time, keyframe.Components, sample.Time, sample.Components,
+      record.DroppedTimes[i], record.DroppedComponents.data() + i*numComponents, tolerance);
+  }
+
+  if (dropLastSample)
+  {
+    attrib.ClearAtTime(record.LastSample.Time);
+    record.DroppedTimes.push_back(record.LastSample.Time);
+    record.DroppedComponents.insert(record.DroppedComponents.end(), record.LastSample.Components.begin(), record.LastSample.Components.end());
+  }
+  else
+  {
+    record.Keyframe = std::move(record.LastSample);
+    record.DroppedTimes.clear();
+    record.DroppedComponents.clear();
+  }
+
+  attrib.Set(value, timeCode);
+  record.LastSample = std::move(sample);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void UsdBridgeUsdWriter::UpdateUsdTransform(UsdBridgePrimCache* cacheEntry, const SdfPath& transPrimPath, float* transform, bool timeVarying, double timeStep)
 {
   TimeEvaluator<bool> timeEval(timeVarying, timeStep);
 
@@ -884,11 +1258,156 @@ void UsdBridgeUsdWriter::UpdateUsdTransform(const SdfPath& transPrimPath, float*
   transMat.SetRow(2, GfVec4d(GfVec4f(&transform[8])));
   transMat.SetRow(3, GfVec4d(GfVec4f(&transform[12])));
 
-  //Note that instance transform nodes have already been created.
-  UsdGeomXform tfPrim = UsdGeomXform::Get(this->SceneStage, transPrimPath);
-  assert(tfPrim);
-  tfPrim.ClearXformOpOrder();
-  tfPrim.AddTransformOp().Set(transMat, timeEval.Eval());
+  // The transform op is created once and kept in the cache, so updates don't re-author the op order.
+  UsdGeomXformOp& transOp = cacheEntry->TransformOp;
+  if (!transOp)
+  {
+    //Note that instance transform nodes have already been created.
+    UsdGeomXform tfPrim = UsdGeomXform::Get(this->SceneStage, transPrimPath);
+    assert(tfPrim);
+
+    // Reuse a single transform op from an existing session
+    bool resetsXformStack = false;
+    std::vector<UsdGeomXformOp> xformOps = tfPrim.GetOrderedXformOps(&resetsXformStack);
+    if (xformOps.size() == 1 && xformOps[0].GetOpType() == UsdGeomXformOp::TypeTransform)
+    {
+      transOp = xformOps[0];
+    }
+    else
+    {
+      tfPrim.ClearXformOpOrder();
+      transOp = tfPrim.AddTransformOp();
+    }
+  }
+
+  const UsdTimeCode& timeCode = timeEval.Eval();
+  GfMatrix4d authoredMat;
+  if (GetAuthoredValueAtTime(transOp.GetAttr(), timeCode, authoredMat) && authoredMat == transMat)
+    return;
+  if (ReduceTimeSample(transOp.GetAttr(), transMat, timeCode)
+    || SkipRedundantTimeSample(transOp.GetAttr(), HashAttributeValue(transMat), timeCode))
+    return;
+
+  transOp.Set(transMat, timeCode);
+}
+
+namespace
+{
+  // Splits a transform of 16 floats (vector in row-space) into the position, orientation and scale of a point instancer.
+  // Mirroring is folded into a negative x scale, shear is not represented.
+  void DecomposeInstanceTransform(const float* transform, GfVec3f& position, GfQuath& orientation, GfVec3f& scale)
+  {
+    GfVec3f axes[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      axes[i] = GfVec3f(&transform[i*4]);
+      scale[i] = axes[i].GetLength();
+      if (scale[i] > 0.0f)
+        axes[i] /= scale[i];
+    }
+    if (GfDot(GfCross(axes[0], axes[1]), axes[2]) < 0.0f)
+    {
+      scale[0] = -scale[0];
+      axes[0] = -axes[0];
+    }
+
+    GfMatrix4d rotMat(1.0);
+    for (int i = 0; i < 3; ++i)
+      rotMat.SetRow3(i, GfVec3d(axes[i]));
+    orientation = GfQuath(rotMat.ExtractRotationQuat());
+    position = GfVec3f(&transform[12]);
+  }
+}
+
+void UsdBridgeUsdWriter::UpdateUsdInstancer(UsdBridgePrimCache* worldCache, UsdBridgePrimCache* groupCache, const char* instancerPathExt,
+  const float* transforms, const uint64_t* instanceIds, uint64_t numInstances, bool timeVarying, double timeStep, const RefModFuncs& refModCallbacks)
+{
+  TimeEvaluator<bool> timeEval(timeVarying, timeStep);
+
+  SdfPath instancerPath = worldCache->PrimPath.AppendPath(SdfPath(instancerPathExt)).AppendPath(groupCache->Name);
+  UsdGeomPointInstancer instancer = UsdGeomPointInstancer::Get(SceneStage, instancerPath);
+
+  if (!instancer)
+  {
+    instancer = UsdGeomPointInstancer::Define(SceneStage, instancerPath);
+    assert(instancer);
+
+    // The group is the single prototype, referenced from below the instancer
+    SdfPath protoPath = instancerPath.AppendPath(groupCache->Name);
+    UsdPrim protoPrim = SceneStage->DefinePrim(protoPath);
+    protoPrim.GetReferences().AddInternalReference(groupCache->PrimPath);
+    instancer.CreatePrototypesRel().SetTargets(SdfPathVector(1, protoPath));
+
+    instancer.CreateProtoIndicesAttr();
+    instancer.CreatePositionsAttr();
+    instancer.CreateOrientationsAttr();
+    instancer.CreateScalesAttr();
+
+#ifdef TIME_BASED_CACHING
+    if (timeVarying)
+      InitializePrimVisibility(SceneStage, instancerPath, timeEval.TimeCode);
+#endif
+
+    worldCache->InstancerArrays.erase(instancerPath);
+    refModCallbacks.AtNewRef(worldCache, groupCache);
+  }
+#ifdef TIME_BASED_CACHING
+  else if (timeVarying)
+    SetPrimVisibility(SceneStage, instancerPath, timeEval.TimeCode, true);
+#endif
+
+  // The arrays of the previous write are kept, so only the elements of which the source transform changed are decomposed again.
+  // Attributes still receive their arrays as a whole.
+  UsdBridgeInstancerArrays& arrays = worldCache->InstancerArrays[instancerPath];
+  bool resized = (arrays.Positions.size() != numInstances);
+  if (resized)
+  {
+    arrays.Transforms.resize(numInstances*16);
+    arrays.ProtoIndices.assign(numInstances, 0);
+    arrays.Positions.resize(numInstances);
+    arrays.Orientations.resize(numInstances);
+    arrays.Scales.resize(numInstances);
+  }
+
+  GfVec3f* positionsData = nullptr;
+  GfQuath* orientationsData = nullptr;
+  GfVec3f* scalesData = nullptr;
+  for (uint64_t i = 0; i < numInstances; ++i)
+  {
+    const float* transform = transforms + instanceIds[i]*16;
+    float* prevTransform = arrays.Transforms.data() + i*16;
+    if (!resized && std::memcmp(prevTransform, transform, 16*sizeof(float)) == 0)
+      continue;
+    std::memcpy(prevTransform, transform, 16*sizeof(float));
+
+    if (!positionsData)
+    {
+      // Detaches the arrays from the values held by the attributes
+      positionsData = arrays.Positions.data();
+      orientationsData = arrays.Orientations.data();
+      scalesData = arrays.Scales.data();
+    }
+    DecomposeInstanceTransform(transform, positionsData[i], orientationsData[i], scalesData[i]);
+  }
+
+  // Time-uniform arrays are only rewritten when changed, as every world commit passes all instances
+  bool changed = resized || positionsData != nullptr;
+  if (!timeVarying && !changed)
+    return;
+
+  {
+    SdfChangeBlock changeBlock;
+
+    const UsdTimeCode& timeCode = timeEval.Eval();
+    if ((resized || timeVarying) && !SkipRedundantTimeSample(instancer.GetProtoIndicesAttr(), HashAttributeValue(arrays.ProtoIndices), timeCode))
+      instancer.GetProtoIndicesAttr().Set(arrays.ProtoIndices, timeCode);
+    if (!SkipRedundantTimeSample(instancer.GetPositionsAttr(), HashAttributeValue(arrays.Positions), timeCode))
+      instancer.GetPositionsAttr().Set(arrays.Positions, timeCode);
+    if (!SkipRedundantTimeSample(instancer.GetOrientationsAttr(), HashAttributeValue(arrays.Orientations), timeCode))
+      instancer.GetOrientationsAttr().Set(arrays.Orientations, timeCode);
+    if (!SkipRedundantTimeSample(instancer.GetScalesAttr(), HashAttributeValue(arrays.Scales), timeCode))
+      instancer.GetScalesAttr().Set(arrays.Scales, timeCode);
+  }
 }
 
 void UsdBridgeUsdWriter::UpdateBeginEndTime(double timeStep)
@@ -1017,5 +1536,5 @@ void RemoveResourceFiles(UsdBridgePrimCache* cache, UsdBridgeUsdWriter& usdWrite
       usdWriter.Connect->RemoveFile(volFileName.c_str(), true);
     }
   }
-  keys.resize(0);
+  keys.clear();
 }
\ No newline at end of file
@@ -14,6 +14,9 @@ PXR_NAMESPACE_USING_DIRECTIVE
 
 #include <memory>
 #include <functional>
+#include <map>
+#include <set>
+#include <unordered_set>
 
 //Includes detailed usd translation interface of Usd Bridge
 class UsdBridgeUsdWriter
@@ -51,14 +54,17 @@ public:
     , bool useClipStage = false, const char* clipPf = nullptr, double timeStep = 0.0
     , std::function<void (UsdStageRefPtr)> initFunc = [](UsdStageRefPtr){}
 #endif
-    ) const;
+    );
 #ifdef VALUE_CLIP_RETIMING
   void CreateManifestStage(const char* name, const char* primPostfix, UsdBridgePrimCache* cacheEntry);
   void RemoveManifestAndClipStages(const UsdBridgePrimCache* cacheEntry);
 
-  const UsdStagePair& FindOrCreatePrimStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix) const;
-  const UsdStagePair& FindOrCreateClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, double timeStep, bool& exists) const;
-  const UsdStagePair& FindOrCreatePrimClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, bool isClip, double timeStep, bool& exists) const;
+  const UsdStagePair& FindOrCreatePrimStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix);
+  const UsdStagePair& FindOrCreateClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, double timeStep, bool& exists);
+  const UsdStagePair& FindOrCreatePrimClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, bool isClip, double timeStep, bool& exists);
+#endif
+#ifdef TIME_CLIP_STAGES
+  void SaveClipStages(); // Writes the clip stages accessed since the last call to their files
 #endif
   void SetSceneGraphRoot(UsdBridgePrimCache* worldCache, const char* name);
   void RemoveSceneGraphRoot(UsdBridgePrimCache* worldCache);
@@ -79,8 +85,11 @@ public:
 #endif
 
 #ifdef VALUE_CLIP_RETIMING
-  void InitializeClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix);
-  void UpdateClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix);
+  void InitializeClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* parentCache, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix);
+  void UpdateClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* parentCache, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix);
+  UsdBridgeClipMetaData& GetClipMetaData(UsdBridgePrimCache* parentCache, const UsdPrim& clipPrim);
+  bool HasClipMetaData(const UsdBridgePrimCache* parentCache, const UsdPrim& clipPrim) const;
+  void ClearClipMetaData(UsdBridgePrimCache* parentCache, const UsdPrim& clipPrim); // For references which are no longer retimed
 #endif
 
   SdfPath AddRef_NoClip(UsdBridgePrimCache* parentCache, UsdBridgePrimCache* childCache, const char* refPathExt,
@@ -115,6 +124,8 @@ public:
   void UpdateUsdGeometryManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeMeshData& meshData);
   void UpdateUsdGeometryManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeInstancerData& instancerData);
   void UpdateUsdGeometryManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeCurveData& curveData);
+  void UpdateUsdGeometryChunksManifest(const UsdBridgePrimCache* geomCache, const UsdBridgeMeshData* chunkData, uint32_t numChunks);
+  void UpdateUsdGeometryChunksManifest(const UsdBridgePrimCache* geomCache, const UsdBridgeInstancerData* chunkData, uint32_t numChunks);
   void UpdateUsdVolumeManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeVolumeData& volumeData);
   void UpdateUsdMaterialManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeMaterialData& matData);
   void UpdateUsdSamplerManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeSamplerData& samplerData);
@@ -126,10 +137,20 @@ public:
 
   void UnbindMaterialFromGeom(const SdfPath & refGeomPath);
 
-  void UpdateUsdTransform(const SdfPath& transPrimPath, float* transform, bool timeVarying, double timeStep);
-  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& meshPath, const UsdBridgeMeshData& geomData, double timeStep);
-  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& instancerPath, const UsdBridgeInstancerData& geomData, double timeStep);
-  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& curvePath, const UsdBridgeCurveData& geomData, double timeStep);
+  void SetGeometryPrototypeRef(const UsdBridgePrimCache* geomCache, const UsdBridgePrimCache* protoCache); // protoCache may be null to remove the reference
+  void UpdateUsdGeometryLods(const UsdBridgePrimCache* geomCache, const UsdBridgePrimCache* lodCache, const UsdBridgeMeshData* lodData, uint32_t numLods, double timeStep);
+  void RemoveUsdGeometryLods(const UsdBridgePrimCache* geomCache, const UsdBridgePrimCache* lodCache);
+  void ConvertToChunkedGeometry(const UsdBridgePrimCache* geomCache);
+  void UpdateUsdGeometryChunks(UsdStageRefPtr timeVarStage, UsdBridgePrimCache* geomCache, const UsdBridgeMeshData* chunkData, uint32_t numChunks, double timeStep);
+  void UpdateUsdGeometryChunks(UsdStageRefPtr timeVarStage, UsdBridgePrimCache* geomCache, const UsdBridgeInstancerData* chunkData, uint32_t numChunks, double timeStep);
+
+  void UpdateUsdTransform(UsdBridgePrimCache* cacheEntry, const SdfPath& transPrimPath, float* transform, bool timeVarying, double timeStep);
+  void UpdateUsdInstancer(UsdBridgePrimCache* worldCache, UsdBridgePrimCache* groupCache, const char* instancerPathExt, const float* transforms, const uint64_t* instanceIds, uint64_t numInstances, bool timeVarying, double timeStep, const RefModFuncs& refModCallbacks);
+  // cacheEntry (optional) is the geometry owning the prim, in which meshes keep track of their authored topology
+  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& meshPath, const UsdBridgeMeshData& geomData, double timeStep, UsdBridgePrimCache* cacheEntry = nullptr);
+  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& instancerPath, const UsdBridgeInstancerData& geomData, double timeStep, UsdBridgePrimCache* cacheEntry = nullptr);
+  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& curvePath, const UsdBridgeCurveData& geomData, double timeStep, UsdBridgePrimCache* cacheEntry = nullptr);
+  void CreateUsdMaterialAttributeReaders(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, const UsdBridgeMaterialData& matData, double timeStep); // Defines prims, so call outside of change blocks
   void UpdateUsdMaterial(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, const UsdBridgeMaterialData& matData, double timeStep);
   void UpdatePsShader(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, const SdfPath& shadPrimPath, const UsdBridgeMaterialData& matData, double timeStep);
   void UpdateMdlShader(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, const SdfPath& shadPrimPath, const UsdBridgeMaterialData& matData, double timeStep);
@@ -140,6 +161,9 @@ public:
   void UpdateAttributeReaders(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, MaterialDMI dataMemberId, const char* newName, double timeStep, MaterialDMI timeVarying);
   void UpdateInAttribute(UsdStageRefPtr timeVarStage, const SdfPath& samplerPrimPath, const char* newName, double timeStep, SamplerDMI timeVarying);
   void UpdateBeginEndTime(double timeStep);
+#ifdef VALUE_CLIP_RETIMING
+  void FlushClipMetaData(); // Authors the modified clip metadata arrays, required before the scene stage is saved or read
+#endif
 
   void* LogUserData;
   UsdBridgeLogCallback LogCallback;
@@ -148,6 +172,26 @@ public:
 
   TfToken& AttributeNameToken(const char* attribName);
 
+  // Returns whether writing a value with hash valueHash at timeCode can be skipped, as it equals the previous timesample of attrib.
+  // A skipped sample is still implied when reading, under held as well as linear interpolation: once the value changes,
+  // the previous value is authored again at the last skipped timestep.
+  bool SkipRedundantTimeSample(const UsdAttribute& attrib, uint64_t valueHash, const UsdTimeCode& timeCode);
+
+  // Keyframe reduction within Settings.TimeCompressionTolerance, for timesamples of linearly interpolated scalars, vectors and matrices.
+  // Returns whether the value has been handled, ie. authored or dropped, otherwise the caller writes it.
+  template<typename ValueType>
+  bool ReduceTimeSample(const UsdAttribute& attrib, const ValueType& value, const UsdTimeCode& timeCode)
+  {
+    return Settings.TimeCompressionTolerance > 0.0f && !timeCode.IsDefault() && ReduceTimeSampleValue(attrib, VtValue(value), timeCode);
+  }
+  bool ReduceTimeSampleValue(const UsdAttribute& attrib, const VtValue& value, const UsdTimeCode& timeCode);
+
+  // Quantized attributes (by path) of which data has exceeded the error bound, declared in full precision in all layers from then on
+  std::set<SdfPath> FullPrecisionAttributes;
+  // Records the attribute and converts its existing specs and values in the scene layer, the layer of outAttrib
+  // and, if cacheEntry is given, the manifest and clip layers of the prim
+  void PromoteToFullPrecision(const UsdBridgePrimCache* cacheEntry, const SdfPath& attribPath, const UsdAttribute& outAttrib);
+
   friend void ResourceCollectVolume(UsdBridgePrimCache* cache, UsdBridgeUsdWriter& usdWriter);
   friend void ResourceCollectSampler(UsdBridgePrimCache* cache, UsdBridgeUsdWriter& usdWriter);
   friend void RemoveResourceFiles(UsdBridgePrimCache* cache, UsdBridgeUsdWriter& usdWriter, 
@@ -177,6 +221,53 @@ protected:
   bool RemoveSharedResourceRef(const UsdBridgeResourceKey& key);
   bool IsSharedResourceModified(const UsdBridgeResourceKey& key);
 
+  template<typename GeomDataType>
+  void UpdateUsdGeometryChunksTemplate(UsdStageRefPtr timeVarStage, UsdBridgePrimCache* geomCache, const GeomDataType* chunkData, uint32_t numChunks, double timeStep);
+#ifdef VALUE_CLIP_RETIMING
+  template<typename GeomDataType>
+  void UpdateUsdGeometryChunksManifestTemplate(const UsdBridgePrimCache* geomCache, const GeomDataType* chunkData, uint32_t numChunks);
+#endif
+
+  // Per attribute (and stage), the hash of its last authored timesample and the later timesteps at which writing the same value was skipped
+  struct TimeSampleRecord
+  {
+    double AuthoredTime = 0.0;
+    uint64_t ValueHash = 0;
+    std::vector<double> SkippedTimes;
+  };
+  // Ordered by path first, so the records of a prim and its descendants form a single range
+  using TimeSampleKey = std::pair<SdfPath, const UsdStage*>;
+  std::map<TimeSampleKey, TimeSampleRecord> TimeSampleRecords;
+#ifdef TIME_CLIP_STAGES
+  // Clip stages receive the samples of a single timestep. A skipped sample would leave its clip without a value for the attribute,
+  // as value clips don't fall back to earlier clips, so their samples are not deduplicated.
+  std::unordered_set<const UsdStage*> TimeStepClipStages;
+#endif
+
+  // Per attribute (and stage) under keyframe reduction, the last keyframe, the last sample (authored until a later sample makes it redundant)
+  // and the samples in between that are dropped, as they are reproduced by interpolating between the keyframe and the last sample.
+  // Only the interpolated components of the dropped samples are kept, stored consecutively.
+  struct KeyframeSample
+  {
+    double Time = 0.0;
+    std::vector<double> Components;
+  };
+  struct KeyframeRecord
+  {
+    KeyframeSample Keyframe;
+    KeyframeSample LastSample;
+    std::vector<double> DroppedTimes;
+    std::vector<double> DroppedComponents;
+  };
+  std::map<TimeSampleKey, KeyframeRecord> KeyframeRecords;
+
+#ifdef VALUE_CLIP_RETIMING
+  UsdBridgePrimCacheList ModifiedClipMetaData; // Parents with clip metadata that hasn't been authored yet
+#endif
+#ifdef TIME_CLIP_STAGES
+  std::set<SdfLayerHandle> UnsavedClipLayers; // Root layers of clip stages accessed since the last SaveClipStages()
+#endif
+
   // Token cache for attribute names
   std::vector<TfToken> AttributeTokens;
 
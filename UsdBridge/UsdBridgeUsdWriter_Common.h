@@ -6,9 +6,11 @@
 
 #include "UsdBridgeTimeEvaluator.h"
 #include "UsdBridgeData.h"
+#include "UsdBridgeUtils.h"
 
 #include <string>
 #include <sstream>
+#include <type_traits>
 
 template<typename T>
 using TimeEvaluator = UsdBridgeTimeEvaluator<T>;
@@ -21,7 +23,8 @@ using TimeEvaluator = UsdBridgeTimeEvaluator<T>;
 
 #define MISC_TOKEN_SEQ \
   (Root) \
-  (extent)
+  (extent) \
+  (lod)
 
 #define ATTRIB_TOKEN_SEQ \
   (faceVertexCounts) \
@@ -150,6 +153,7 @@ namespace constring
   extern const char* const psSamplerPrimPf;
   extern const char* const mdlSamplerPrimPf;
   extern const char* const openVDBPrimPf;
+  extern const char* const geomChunkPrimPf;
 
   // Extensions
   extern const char* const imageExtension;
@@ -584,6 +588,45 @@ namespace
     return prim;
   }
 
+  bool HasTimeSampleAt(const UsdAttribute& attrib, double timeStep)
+  {
+    double lower, upper;
+    bool hasTimeSamples = false;
+    return attrib.GetBracketingTimeSamples(timeStep, &lower, &upper, &hasTimeSamples) && hasTimeSamples
+      && lower == timeStep && upper == timeStep;
+  }
+
+  // Retrieves the value authored at exactly timeCode, ie. a timesample at that time, or the default value for the default time.
+  // Returns false if no such value exists, as opposed to a value that is interpolated or falls back.
+  template<typename T>
+  bool GetAuthoredValueAtTime(const UsdAttribute& attrib, const UsdTimeCode& timeCode, T& value)
+  {
+    if (timeCode.IsDefault())
+    {
+      if (attrib.GetResolveInfo(timeCode).GetSource() != UsdResolveInfoSourceDefault)
+        return false;
+    }
+    else if (!HasTimeSampleAt(attrib, timeCode.GetValue()))
+      return false;
+    return attrib.Get(&value, timeCode);
+  }
+
+  // Hash used to detect repeated attribute values; arrays and values of trivially copyable types are hashed by their bytes
+  template<typename T>
+  uint64_t HashAttributeValue(const T& value, std::true_type) { return UsdBridgeHashData(&value, sizeof(T)); }
+
+  template<typename T>
+  uint64_t HashAttributeValue(const T& value, std::false_type) { return VtValue(value).GetHash(); }
+
+  template<typename T>
+  uint64_t HashAttributeValue(const VtArray<T>& value, std::true_type) { return UsdBridgeHashData(value.cdata(), value.size()*sizeof(T)); }
+
+  template<typename T>
+  uint64_t HashAttributeValue(const T& value) { return HashAttributeValue(value, std::is_trivially_copyable<T>()); }
+
+  template<typename T>
+  uint64_t HashAttributeValue(const VtArray<T>& value) { return HashAttributeValue(value, std::is_trivially_copyable<T>()); }
+
   void ClearUsdAttributes(const UsdAttribute& uniformAttrib, const UsdAttribute& timeVarAttrib, bool timeVaryingUpdate)
   {
 #ifdef TIME_BASED_CACHING
@@ -4,6 +4,8 @@
 #include "UsdBridgeUsdWriter.h"
 
 #include "UsdBridgeUsdWriter_Common.h"
+#include "UsdBridgeUtils.h"
+#include "UsdBridgeParallel.h"
 
 namespace
 {
@@ -30,141 +32,242 @@ namespace
   template<>
   UsdAttribute UsdGeomGetPointsAttribute(UsdGeomPointInstancer& usdGeom) { return usdGeom.GetPositionsAttr(); }
 
+  // Timesamples equal to the previous one are skipped.
+  // With direct layer authoring, values are written into the attribute spec of the edit target layer, which skips the 
+  // composition lookups and value validation of UsdAttribute::Set. Attributes without a spec in that layer are set through the stage.
+  template<typename ValueType>
+  void SetAttributeValue(UsdBridgeUsdWriter* writer, const UsdAttribute& attr, const ValueType& value, const UsdTimeCode& timeCode)
+  {
+    if (!timeCode.IsDefault() && writer->SkipRedundantTimeSample(attr, HashAttributeValue(value), timeCode))
+      return;
+
+    if (writer->Settings.EnableDirectLayerAuthoring)
+    {
+      const UsdEditTarget& editTarget = attr.GetStage()->GetEditTarget();
+      const SdfLayerHandle& layer = editTarget.GetLayer();
+      const SdfPath& attrPath = attr.GetPath();
+      if (editTarget.GetMapFunction().IsIdentity() && layer->HasSpec(attrPath))
+      {
+        if (timeCode.IsDefault())
+          layer->SetField(attrPath, SdfFieldKeys->Default, value);
+        else
+          layer->SetTimeSample(attrPath, timeCode.GetValue(), value);
+        return;
+      }
+    }
+    attr.Set(value, timeCode);
+  }
+
   // Array assignment
   template<class ArrayType>
-  void AssignArrayToPrimvar(const void* data, size_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
+  void AssignArrayToPrimvar(UsdBridgeUsdWriter* writer, const void* data, size_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
   {
     using ElementType = typename ArrayType::ElementType;
     ElementType* typedData = (ElementType*)data;
     usdArray->assign(typedData, typedData + numElements);
 
-    primvar.Set(*usdArray, timeCode);
+    SetAttributeValue(writer, primvar, *usdArray, timeCode);
   }
 
-  template<class ArrayType>
-  void AssignArrayToPrimvarFlatten(const void* data, UsdBridgeType dataType, size_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
+  // Multi-component types follow the fundamental types (except BOOL) in groups of equal size
+  constexpr int UsdBridgeNumComponentTypes = (int)UsdBridgeType::UCHAR2 - (int)UsdBridgeType::UCHAR;
+
+  int GetNumComponents(UsdBridgeType dataType)
   {
-    int elementMultiplier = (int)dataType / UsdBridgeNumFundamentalTypes;
-    size_t numFlattenedElements = numElements * elementMultiplier;
+    if (dataType == UsdBridgeType::BOOL || dataType == UsdBridgeType::UNDEFINED)
+      return 1;
+    return 1 + ((int)dataType - (int)UsdBridgeType::UCHAR) / UsdBridgeNumComponentTypes;
+  }
 
-    AssignArrayToPrimvar<ArrayType>(data, numFlattenedElements, primvar, timeCode, usdArray);
+  UsdBridgeType GetComponentType(UsdBridgeType dataType)
+  {
+    if (dataType == UsdBridgeType::BOOL || dataType == UsdBridgeType::UNDEFINED)
+      return dataType;
+    return (UsdBridgeType)((int)UsdBridgeType::UCHAR + ((int)dataType - (int)UsdBridgeType::UCHAR) % UsdBridgeNumComponentTypes);
   }
 
+  // Conversion kernels write through plain pointers into the output arrays (VtArray element access checks for detaching),
+  // so their loops vectorize. Large arrays are split over threads.
+
   template<class ArrayType, class EltType>
-  void AssignArrayToPrimvarConvert(const void* data, size_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
+  void AssignArrayToPrimvarConvert(UsdBridgeUsdWriter* writer, const void* data, size_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
   {
     using ElementType = typename ArrayType::ElementType;
-    EltType* typedData = (EltType*)data;
+    const EltType* typedData = reinterpret_cast<const EltType*>(data);
 
     usdArray->resize(numElements);
-    for (int i = 0; i < numElements; ++i)
-    {
-      (*usdArray)[i] = ElementType(typedData[i]);
-    }
-
-    primvar.Set(*usdArray, timeCode);
-  }
-
-  template<class ArrayType, class EltType>
-  void AssignArrayToPrimvarConvertFlatten(const void* data, UsdBridgeType dataType, size_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
-  {
-    int elementMultiplier = (int)dataType / UsdBridgeNumFundamentalTypes;
-    size_t numFlattenedElements = numElements * elementMultiplier;
+    ElementType* output = usdArray->data();
+    UsdBridgeParallelFor(numElements, [typedData, output](size_t, size_t begin, size_t end)
+      {
+        for (size_t i = begin; i < end; ++i)
+          output[i] = ElementType(typedData[i]);
+      });
 
-    AssignArrayToPrimvarConvert<ArrayType, EltType>(data, numFlattenedElements, primvar, timeCode, usdArray);
+    SetAttributeValue(writer, primvar, *usdArray, timeCode);
   }
 
   template<typename ArrayType, typename EltType>
-  void Expand1ToVec3(const void* data, uint64_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
+  void Expand1ToVec3(UsdBridgeUsdWriter* writer, const void* data, uint64_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
   {
+    using ScalarType = typename ArrayType::ElementType::ScalarType;
+
     usdArray->resize(numElements);
     const EltType* typedInput = reinterpret_cast<const EltType*>(data);
-    for (int i = 0; i < numElements; ++i)
-    {
-      (*usdArray)[i] = typename ArrayType::ElementType(typedInput[i], typedInput[i], typedInput[i]);
-    }
-    primvar.Set(*usdArray, timeCode);
+    ScalarType* output = reinterpret_cast<ScalarType*>(usdArray->data());
+    UsdBridgeParallelFor(numElements, [typedInput, output](size_t, size_t begin, size_t end)
+      {
+        for (size_t i = begin; i < end; ++i)
+        {
+          ScalarType value = ScalarType(typedInput[i]);
+          output[i*3] = value;
+          output[i*3+1] = value;
+          output[i*3+2] = value;
+        }
+      });
+    SetAttributeValue(writer, primvar, *usdArray, timeCode);
   }
 
-  template<typename InputEltType, int numComponents>
-  void ExpandToColor(const void* data, uint64_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, VtVec4fArray* usdArray)
+  // Missing color components are 0, missing alpha is 1. Integer input is normalized to [0,1] if requested.
+  template<typename InputEltType, int numComponents, bool normalize>
+  void ConvertToColor(const InputEltType* input, size_t begin, size_t end, float* output)
   {
-    usdArray->resize(numElements);
-    const InputEltType* typedInput = reinterpret_cast<const InputEltType*>(data);
-    // No memcopies, as input is not guaranteed to be of float type
-    if(numComponents == 1)
-      for (int i = 0; i < numElements; ++i)
-        (*usdArray)[i] = GfVec4f(typedInput[i], 0.0f, 0.0f, 1.0f);
-    if(numComponents == 2)
-      for (int i = 0; i < numElements; ++i)
-        (*usdArray)[i] = GfVec4f(typedInput[i*2], typedInput[i*2+1], 0.0f, 1.0f);
-    if(numComponents == 3)
-      for (int i = 0; i < numElements; ++i)
-        (*usdArray)[i] = GfVec4f(typedInput[i*3], typedInput[i*3+1], typedInput[i*3+2], 1.0f);
-    primvar.Set(*usdArray, timeCode);
+    const double normFactor = 1.0 / (double)std::numeric_limits<InputEltType>::max(); // float may not be enough for uint32_t
+    for (size_t i = begin; i < end; ++i)
+    {
+      for (int comp = 0; comp < 4; ++comp)
+      {
+        if (comp < numComponents)
+          output[i*4+comp] = float(normalize ? input[i*numComponents+comp]*normFactor : input[i*numComponents+comp]);
+        else
+          output[i*4+comp] = (comp == 3) ? 1.0f : 0.0f;
+      }
+    }
   }
 
-  template<typename InputEltType, int numComponents>
-  void ExpandToColorNormalize(const void* data, uint64_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, VtVec4fArray* usdArray)
+  template<typename InputEltType, int numComponents, bool normalize>
+  void ExpandToColor(UsdBridgeUsdWriter* writer, const void* data, uint64_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, VtVec4fArray* usdArray)
   {
     usdArray->resize(numElements);
     const InputEltType* typedInput = reinterpret_cast<const InputEltType*>(data);
-    double normFactor = 1.0f / (double)std::numeric_limits<InputEltType>::max(); // float may not be enough for uint32_t
+    float* output = reinterpret_cast<float*>(usdArray->data());
     // No memcopies, as input is not guaranteed to be of float type
-    if(numComponents == 1)
-      for (int i = 0; i < numElements; ++i)
-        (*usdArray)[i] = GfVec4f(typedInput[i]*normFactor, 0.0f, 0.0f, 1.0f);
-    if(numComponents == 2)
-      for (int i = 0; i < numElements; ++i)
-        (*usdArray)[i] = GfVec4f(typedInput[i*2]*normFactor, typedInput[i*2+1]*normFactor, 0.0f, 1.0f);
-    if(numComponents == 3)
-      for (int i = 0; i < numElements; ++i)
-        (*usdArray)[i] = GfVec4f(typedInput[i*3]*normFactor, typedInput[i*3+1]*normFactor, typedInput[i*3+2]*normFactor, 1.0f);
-    if(numComponents == 4)
-      for (int i = 0; i < numElements; ++i)
-        (*usdArray)[i] = GfVec4f(typedInput[i*4]*normFactor, typedInput[i*4+1]*normFactor, typedInput[i*4+2]*normFactor, typedInput[i*4+3]*normFactor);
-    primvar.Set(*usdArray, timeCode);
+    UsdBridgeParallelFor(numElements, [typedInput, output](size_t, size_t begin, size_t end)
+      {
+        ConvertToColor<InputEltType, numComponents, normalize>(typedInput, begin, end, output);
+      });
+    SetAttributeValue(writer, primvar, *usdArray, timeCode);
   }
 
   #define ASSIGN_PRIMVAR_MACRO(ArrayType) \
-    ArrayType& usdArray = GetStaticTempArray<ArrayType>(); AssignArrayToPrimvar<ArrayType>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray)
-  #define ASSIGN_PRIMVAR_FLATTEN_MACRO(ArrayType) \
-    ArrayType& usdArray = GetStaticTempArray<ArrayType>(); AssignArrayToPrimvarFlatten<ArrayType>(arrayData, arrayDataType, arrayNumElements, arrayPrimvar, timeCode, &usdArray)
+    ArrayType& usdArray = GetStaticTempArray<ArrayType>(); AssignArrayToPrimvar<ArrayType>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray)
   #define ASSIGN_PRIMVAR_CONVERT_MACRO(ArrayType, EltType) \
-    ArrayType& usdArray = GetStaticTempArray<ArrayType>(); AssignArrayToPrimvarConvert<ArrayType, EltType>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray)
-  #define ASSIGN_PRIMVAR_CONVERT_FLATTEN_MACRO(ArrayType, EltType) \
-    ArrayType& usdArray = GetStaticTempArray<ArrayType>(); AssignArrayToPrimvarConvertFlatten<ArrayType, EltType>(arrayData, arrayDataType, arrayNumElements, arrayPrimvar, timeCode, &usdArray)
+    ArrayType& usdArray = GetStaticTempArray<ArrayType>(); AssignArrayToPrimvarConvert<ArrayType, EltType>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray)
   #define ASSIGN_PRIMVAR_CUSTOM_ARRAY_MACRO(ArrayType, customArray) \
-    AssignArrayToPrimvar<ArrayType>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &customArray)
+    AssignArrayToPrimvar<ArrayType>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &customArray)
   #define ASSIGN_PRIMVAR_CONVERT_CUSTOM_ARRAY_MACRO(ArrayType, EltType, customArray) \
-    AssignArrayToPrimvarConvert<ArrayType, EltType>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &customArray)
+    AssignArrayToPrimvarConvert<ArrayType, EltType>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &customArray)
   #define ASSIGN_PRIMVAR_MACRO_1EXPAND3(ArrayType, EltType) \
-    ArrayType& usdArray = GetStaticTempArray<ArrayType>(); Expand1ToVec3<ArrayType, EltType>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
+    ArrayType& usdArray = GetStaticTempArray<ArrayType>(); Expand1ToVec3<ArrayType, EltType>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
   #define ASSIGN_PRIMVAR_MACRO_1EXPAND_COL(EltType) \
-    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColor<EltType, 1>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
+    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColor<EltType, 1, false>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
   #define ASSIGN_PRIMVAR_MACRO_2EXPAND_COL(EltType) \
-    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColor<EltType, 2>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
+    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColor<EltType, 2, false>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
   #define ASSIGN_PRIMVAR_MACRO_3EXPAND_COL(EltType) \
-    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColor<EltType, 3>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
+    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColor<EltType, 3, false>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
   #define ASSIGN_PRIMVAR_MACRO_1EXPAND_NORMALIZE_COL(EltType) \
-    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColorNormalize<EltType, 1>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
+    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColor<EltType, 1, true>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
   #define ASSIGN_PRIMVAR_MACRO_2EXPAND_NORMALIZE_COL(EltType) \
-    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColorNormalize<EltType, 2>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
+    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColor<EltType, 2, true>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
   #define ASSIGN_PRIMVAR_MACRO_3EXPAND_NORMALIZE_COL(EltType) \
-    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColorNormalize<EltType, 3>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
+    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColor<EltType, 3, true>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
   #define ASSIGN_PRIMVAR_MACRO_4EXPAND_NORMALIZE_COL(EltType) \
-    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColorNormalize<EltType, 4>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
+    VtVec4fArray& usdArray = GetStaticTempArray<VtVec4fArray>(); ExpandToColor<EltType, 4, true>(writer, arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray);
 
-  void CopyArrayToPrimvar(UsdBridgeUsdWriter* writer, const void* arrayData, UsdBridgeType arrayDataType, size_t arrayNumElements, UsdAttribute arrayPrimvar, const UsdTimeCode& timeCode)
+  // Multi-component types without an equivalent Vt array are written as arrays of their components
+  bool IsFlattenedPrimvarType(UsdBridgeType dataType)
   {
-    SdfValueTypeName primvarType = GetPrimvarArrayType(arrayDataType);
+    UsdBridgeType componentType = GetComponentType(dataType);
+    return GetNumComponents(dataType) > 1 &&
+      componentType != UsdBridgeType::INT && componentType != UsdBridgeType::FLOAT && componentType != UsdBridgeType::DOUBLE;
+  }
+
+  // Arrays repeating a single value are written as that value, with constant interpolation. Interpolation is shared by all timesteps, 
+  // so this is restricted to time-uniform data.
+  void ReduceToConstantPrimvar(const void* arrayData, UsdBridgeType arrayDataType, bool timeVaryingUpdate, size_t& arrayNumElements, TfToken& interpolation)
+  {
+    size_t elementSize = UsdBridgeTypeSize(arrayDataType);
+    if (!timeVaryingUpdate && arrayNumElements > 1 && elementSize && !IsFlattenedPrimvarType(arrayDataType) 
+      && UsdBridgeIsConstantArray(arrayData, elementSize, arrayNumElements))
+    {
+      arrayNumElements = 1;
+      interpolation = UsdGeomTokens->constant;
+    }
+  }
 
+  // Low-cardinality arrays are written as their distinct values, referred to per element by the indices of the primvar.
+  // The indices attribute is not part of clip manifests, so this is restricted to time-uniform data.
+  bool IndexPrimvarValues(const UsdBridgeSettings& settings, const void*& arrayData, UsdBridgeType arrayDataType, size_t outputElementSize,
+    bool timeVaryingUpdate, size_t& arrayNumElements, std::vector<char>& values, VtIntArray& indices)
+  {
+    // Indices take an int per element, so smaller output elements gain nothing
+    size_t elementSize = UsdBridgeTypeSize(arrayDataType);
+    if (!settings.EnableIndexedPrimvars || timeVaryingUpdate || arrayNumElements < 2 || !elementSize
+      || outputElementSize <= sizeof(int) || IsFlattenedPrimvarType(arrayDataType))
+      return false;
+
+    indices.resize(arrayNumElements);
+    if (!UsdBridgeFindDistinctElements(arrayData, elementSize, arrayNumElements, settings.IndexedPrimvarMaxValues, values, indices.data()))
+      return false;
+
+    arrayData = values.data();
+    arrayNumElements = values.size() / elementSize;
+    return true;
+  }
+
+  void UpdatePrimvarIndices(const UsdGeomPrimvar& uniformPrimvar, bool indexed, const VtIntArray& indices)
+  {
+    if (indexed)
+    {
+      uniformPrimvar.SetIndices(indices);
+    }
+    else
+    {
+      UsdAttribute indicesAttr = uniformPrimvar.GetIndicesAttr();
+      if (indicesAttr)
+        uniformPrimvar.GetAttr().GetPrim().RemoveProperty(indicesAttr.GetName());
+    }
+  }
+
+  void CopyArrayToPrimvar(UsdBridgeUsdWriter* writer, const void* arrayData, UsdBridgeType arrayDataType, size_t arrayNumElements, UsdAttribute arrayPrimvar, const UsdTimeCode& timeCode)
+  {
+    // Vector types with an equivalent Vt array are copied as a whole
     switch (arrayDataType)
+    {
+      case UsdBridgeType::INT2: { ASSIGN_PRIMVAR_MACRO(VtVec2iArray); return; }
+      case UsdBridgeType::FLOAT2: { ASSIGN_PRIMVAR_MACRO(VtVec2fArray); return; }
+      case UsdBridgeType::DOUBLE2: { ASSIGN_PRIMVAR_MACRO(VtVec2dArray); return; }
+
+      case UsdBridgeType::INT3: { ASSIGN_PRIMVAR_MACRO(VtVec3iArray); return; }
+      case UsdBridgeType::FLOAT3: { ASSIGN_PRIMVAR_MACRO(VtVec3fArray); return; }
+      case UsdBridgeType::DOUBLE3: { ASSIGN_PRIMVAR_MACRO(VtVec3dArray); return; }
+
+      case UsdBridgeType::INT4: { ASSIGN_PRIMVAR_MACRO(VtVec4iArray); return; }
+      case UsdBridgeType::FLOAT4: { ASSIGN_PRIMVAR_MACRO(VtVec4fArray); return; }
+      case UsdBridgeType::DOUBLE4: { ASSIGN_PRIMVAR_MACRO(VtVec4dArray); return; }
+
+      default: break;
+    }
+
+    // Other types are written per component, ie. multi-component types are flattened
+    UsdBridgeType arrayComponentType = GetComponentType(arrayDataType);
+    arrayNumElements *= GetNumComponents(arrayDataType);
+
+    switch (arrayComponentType)
     {
       case UsdBridgeType::UCHAR: { ASSIGN_PRIMVAR_MACRO(VtUCharArray); break; }
       case UsdBridgeType::CHAR: { ASSIGN_PRIMVAR_MACRO(VtUCharArray); break; }
-      case UsdBridgeType::USHORT: { ASSIGN_PRIMVAR_CONVERT_MACRO(VtUIntArray, short); break; }
-      case UsdBridgeType::SHORT: { ASSIGN_PRIMVAR_CONVERT_MACRO(VtIntArray, unsigned short); break; }
+      case UsdBridgeType::USHORT: { ASSIGN_PRIMVAR_CONVERT_MACRO(VtUIntArray, unsigned short); break; }
+      case UsdBridgeType::SHORT: { ASSIGN_PRIMVAR_CONVERT_MACRO(VtIntArray, short); break; }
       case UsdBridgeType::UINT: { ASSIGN_PRIMVAR_MACRO(VtUIntArray); break; }
       case UsdBridgeType::INT: { ASSIGN_PRIMVAR_MACRO(VtIntArray); break; }
       case UsdBridgeType::LONG: { ASSIGN_PRIMVAR_MACRO(VtInt64Array); break; }
@@ -173,49 +276,250 @@ namespace
       case UsdBridgeType::FLOAT: { ASSIGN_PRIMVAR_MACRO(VtFloatArray); break; }
       case UsdBridgeType::DOUBLE: { ASSIGN_PRIMVAR_MACRO(VtDoubleArray); break; }
 
-      case UsdBridgeType::INT2: { ASSIGN_PRIMVAR_MACRO(VtVec2iArray); break; }
-      case UsdBridgeType::FLOAT2: { ASSIGN_PRIMVAR_MACRO(VtVec2fArray); break; }
-      case UsdBridgeType::DOUBLE2: { ASSIGN_PRIMVAR_MACRO(VtVec2dArray); break; }
-
-      case UsdBridgeType::INT3: { ASSIGN_PRIMVAR_MACRO(VtVec3iArray); break; }
-      case UsdBridgeType::FLOAT3: { ASSIGN_PRIMVAR_MACRO(VtVec3fArray); break; }
-      case UsdBridgeType::DOUBLE3: { ASSIGN_PRIMVAR_MACRO(VtVec3dArray); break; }
-
-      case UsdBridgeType::INT4: { ASSIGN_PRIMVAR_MACRO(VtVec4iArray); break; }
-      case UsdBridgeType::FLOAT4: { ASSIGN_PRIMVAR_MACRO(VtVec4fArray); break; }
-      case UsdBridgeType::DOUBLE4: { ASSIGN_PRIMVAR_MACRO(VtVec4dArray); break; }
-
-      case UsdBridgeType::UCHAR2:
-      case UsdBridgeType::UCHAR3: 
-      case UsdBridgeType::UCHAR4: { ASSIGN_PRIMVAR_FLATTEN_MACRO(VtUCharArray); break; }
-      case UsdBridgeType::CHAR2:
-      case UsdBridgeType::CHAR3: 
-      case UsdBridgeType::CHAR4: { ASSIGN_PRIMVAR_FLATTEN_MACRO(VtUCharArray); break; }
-      case UsdBridgeType::USHORT2:
-      case UsdBridgeType::USHORT3:
-      case UsdBridgeType::USHORT4: { ASSIGN_PRIMVAR_CONVERT_FLATTEN_MACRO(VtUIntArray, short); break; }
-      case UsdBridgeType::SHORT2:
-      case UsdBridgeType::SHORT3: 
-      case UsdBridgeType::SHORT4: { ASSIGN_PRIMVAR_CONVERT_FLATTEN_MACRO(VtIntArray, unsigned short); break; }
-      case UsdBridgeType::UINT2:
-      case UsdBridgeType::UINT3: 
-      case UsdBridgeType::UINT4: { ASSIGN_PRIMVAR_FLATTEN_MACRO(VtUIntArray); break; }
-      case UsdBridgeType::LONG2:
-      case UsdBridgeType::LONG3: 
-      case UsdBridgeType::LONG4: { ASSIGN_PRIMVAR_FLATTEN_MACRO(VtInt64Array); break; }
-      case UsdBridgeType::ULONG2:
-      case UsdBridgeType::ULONG3: 
-      case UsdBridgeType::ULONG4: { ASSIGN_PRIMVAR_FLATTEN_MACRO(VtUInt64Array); break; }
-      case UsdBridgeType::HALF2:
-      case UsdBridgeType::HALF3: 
-      case UsdBridgeType::HALF4: { ASSIGN_PRIMVAR_FLATTEN_MACRO(VtHalfArray); break; }
-
       default: {UsdBridgeLogMacro(writer, UsdBridgeLogLevel::ERR, "UsdGeom Attribute<Index> primvar copy does not support source data type: " << arrayDataType) break; }
     };
   }
 
+  // Quantized output
+
+  bool IsHalfPrecisionType(const SdfValueTypeName& typeName)
+  {
+    return typeName == SdfValueTypeNames->HalfArray
+      || typeName == SdfValueTypeNames->Half2Array
+      || typeName == SdfValueTypeNames->Half3Array
+      || typeName == SdfValueTypeNames->Half4Array
+      || typeName == SdfValueTypeNames->Normal3hArray
+      || typeName == SdfValueTypeNames->Color4hArray;
+  }
+
+  // Type in which quantized output is declared, or the input type if it is not quantized
+  UsdBridgeType GetQuantizedType(UsdBridgeType dataType)
+  {
+    switch (dataType)
+    {
+      case UsdBridgeType::FLOAT: return UsdBridgeType::HALF;
+      case UsdBridgeType::FLOAT2: return UsdBridgeType::HALF2;
+      case UsdBridgeType::FLOAT3: return UsdBridgeType::HALF3;
+      case UsdBridgeType::FLOAT4: return UsdBridgeType::HALF4;
+      default: return dataType;
+    }
+  }
+
+  // Error is absolute for values up to magnitude 1, relative beyond that (includes overflow to infinity)
+  bool ConvertToHalf(double value, double errorBound, GfHalf& result)
+  {
+    result = GfHalf(float(value));
+    double error = std::abs(double(float(result)) - value);
+    return !(error > errorBound * std::max(1.0, std::abs(value)));
+  }
+
+  template<typename HalfArrayType, typename InputEltType>
+  bool AssignArrayToHalfPrimvar(UsdBridgeUsdWriter* writer, const void* data, size_t numElements, double errorBound, UsdAttribute& primvar, const UsdTimeCode& timeCode)
+  {
+    constexpr size_t numComponents = sizeof(typename HalfArrayType::ElementType) / sizeof(GfHalf);
+
+    HalfArrayType& usdArray = GetStaticTempArray<HalfArrayType>();
+    usdArray.resize(numElements);
+    const InputEltType* typedInput = reinterpret_cast<const InputEltType*>(data);
+    GfHalf* halfOutput = reinterpret_cast<GfHalf*>(usdArray.data());
+    for (size_t i = 0; i < numElements*numComponents; ++i)
+    {
+      if (!ConvertToHalf(typedInput[i], errorBound, halfOutput[i]))
+        return false;
+    }
+
+    SetAttributeValue(writer, primvar, usdArray, timeCode);
+    return true;
+  }
+
+  template<typename InputEltType, int numComponents, bool normalize>
+  bool ExpandToHalfColor(UsdBridgeUsdWriter* writer, const void* data, uint64_t numElements, double errorBound, UsdAttribute& primvar, const UsdTimeCode& timeCode)
+  {
+    VtVec4hArray& usdArray = GetStaticTempArray<VtVec4hArray>();
+    usdArray.resize(numElements);
+    const InputEltType* typedInput = reinterpret_cast<const InputEltType*>(data);
+    double normFactor = normalize ? 1.0 / (double)std::numeric_limits<InputEltType>::max() : 1.0;
+    GfVec4h* halfOutput = usdArray.data();
+    for (uint64_t i = 0; i < numElements; ++i)
+    {
+      for (int c = 0; c < 4; ++c)
+      {
+        double value = (c < numComponents) ? typedInput[i*numComponents + c]*normFactor : (c == 3 ? 1.0 : 0.0);
+        if (!ConvertToHalf(value, errorBound, halfOutput[i][c]))
+          return false;
+      }
+    }
+
+    SetAttributeValue(writer, primvar, usdArray, timeCode);
+    return true;
+  }
+
+  bool AssignNormalsToHalfPrimvar(UsdBridgeUsdWriter* writer, const void* arrayData, UsdBridgeType arrayDataType, size_t arrayNumElements, double errorBound, UsdAttribute& arrayPrimvar, const UsdTimeCode& timeCode)
+  {
+    switch (arrayDataType)
+    {
+      case UsdBridgeType::FLOAT3: return AssignArrayToHalfPrimvar<VtVec3hArray, float>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::DOUBLE3: return AssignArrayToHalfPrimvar<VtVec3hArray, double>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      default: return false;
+    }
+  }
+
+  bool AssignColorsToHalfPrimvar(UsdBridgeUsdWriter* writer, const void* arrayData, UsdBridgeType arrayDataType, size_t arrayNumElements, double errorBound, UsdAttribute& arrayPrimvar, const UsdTimeCode& timeCode)
+  {
+    switch (arrayDataType)
+    {
+      case UsdBridgeType::UCHAR: return ExpandToHalfColor<uint8_t, 1, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::UCHAR2: return ExpandToHalfColor<uint8_t, 2, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::UCHAR3: return ExpandToHalfColor<uint8_t, 3, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::UCHAR4: return ExpandToHalfColor<uint8_t, 4, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::USHORT: return ExpandToHalfColor<uint16_t, 1, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::USHORT2: return ExpandToHalfColor<uint16_t, 2, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::USHORT3: return ExpandToHalfColor<uint16_t, 3, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::USHORT4: return ExpandToHalfColor<uint16_t, 4, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::UINT: return ExpandToHalfColor<uint32_t, 1, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::UINT2: return ExpandToHalfColor<uint32_t, 2, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::UINT3: return ExpandToHalfColor<uint32_t, 3, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::UINT4: return ExpandToHalfColor<uint32_t, 4, true>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::FLOAT: return ExpandToHalfColor<float, 1, false>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::FLOAT2: return ExpandToHalfColor<float, 2, false>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::FLOAT3: return ExpandToHalfColor<float, 3, false>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::FLOAT4: return ExpandToHalfColor<float, 4, false>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::DOUBLE: return ExpandToHalfColor<double, 1, false>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::DOUBLE2: return ExpandToHalfColor<double, 2, false>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::DOUBLE3: return ExpandToHalfColor<double, 3, false>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::DOUBLE4: return ExpandToHalfColor<double, 4, false>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      default: return false;
+    }
+  }
+
+  bool AssignAttributeToHalfPrimvar(UsdBridgeUsdWriter* writer, const void* arrayData, UsdBridgeType arrayDataType, size_t arrayNumElements, double errorBound, UsdAttribute& arrayPrimvar, const UsdTimeCode& timeCode)
+  {
+    switch (arrayDataType)
+    {
+      case UsdBridgeType::FLOAT: return AssignArrayToHalfPrimvar<VtHalfArray, float>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::FLOAT2: return AssignArrayToHalfPrimvar<VtVec2hArray, float>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::FLOAT3: return AssignArrayToHalfPrimvar<VtVec3hArray, float>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      case UsdBridgeType::FLOAT4: return AssignArrayToHalfPrimvar<VtVec4hArray, float>(writer, arrayData, arrayNumElements, errorBound, arrayPrimvar, timeCode);
+      default: return false;
+    }
+  }
+
+  SdfValueTypeName GetFullPrecisionType(const SdfValueTypeName& typeName)
+  {
+    if (typeName == SdfValueTypeNames->HalfArray)
+      return SdfValueTypeNames->FloatArray;
+    else if (typeName == SdfValueTypeNames->Half2Array)
+      return SdfValueTypeNames->Float2Array;
+    else if (typeName == SdfValueTypeNames->Half3Array)
+      return SdfValueTypeNames->Float3Array;
+    else if (typeName == SdfValueTypeNames->Half4Array)
+      return SdfValueTypeNames->Float4Array;
+    else if (typeName == SdfValueTypeNames->Normal3hArray)
+      return SdfValueTypeNames->Normal3fArray;
+    else if (typeName == SdfValueTypeNames->Color4hArray)
+      return SdfValueTypeNames->Color4fArray;
+    return typeName;
+  }
+
+  template<typename FullArrayType, typename HalfArrayType>
+  VtValue ConvertHalfArrayValue(const HalfArrayType& halfArray)
+  {
+    FullArrayType fullArray(halfArray.size());
+    std::copy(halfArray.cbegin(), halfArray.cend(), fullArray.begin());
+    return VtValue(fullArray);
+  }
+
+  // Widens half precision array values, other values (such as value blocks) are returned as-is
+  VtValue ConvertToFullPrecision(const VtValue& value)
+  {
+    if (value.IsHolding<VtHalfArray>())
+      return ConvertHalfArrayValue<VtFloatArray>(value.UncheckedGet<VtHalfArray>());
+    else if (value.IsHolding<VtVec2hArray>())
+      return ConvertHalfArrayValue<VtVec2fArray>(value.UncheckedGet<VtVec2hArray>());
+    else if (value.IsHolding<VtVec3hArray>())
+      return ConvertHalfArrayValue<VtVec3fArray>(value.UncheckedGet<VtVec3hArray>());
+    else if (value.IsHolding<VtVec4hArray>())
+      return ConvertHalfArrayValue<VtVec4fArray>(value.UncheckedGet<VtVec4hArray>());
+    return value;
+  }
+
+  // Redeclares a half precision attribute spec of a layer in full precision, along with its default value and timesamples
+  void PromoteAttributeSpec(const SdfLayerHandle& layer, const SdfPath& attribPath)
+  {
+    SdfAttributeSpecHandle attribSpec = layer->GetAttributeAtPath(attribPath);
+    if (!attribSpec || !IsHalfPrecisionType(attribSpec->GetTypeName()))
+      return;
+
+    layer->SetField(attribPath, SdfFieldKeys->TypeName, VtValue(GetFullPrecisionType(attribSpec->GetTypeName()).GetAsToken()));
+    if (attribSpec->HasDefaultValue())
+      attribSpec->SetDefaultValue(ConvertToFullPrecision(attribSpec->GetDefaultValue()));
+    for (double timeStep : layer->ListTimeSamplesForPath(attribPath))
+    {
+      VtValue sample;
+      if (layer->QueryTimeSample(attribPath, timeStep, &sample))
+        layer->SetTimeSample(attribPath, timeStep, ConvertToFullPrecision(sample));
+    }
+  }
+
+  // Quantized primvars are declared in half precision, unless their data has exceeded the error bound before
+  bool DeclaresHalfPrecision(const UsdGeomPrimvarsAPI& primvarApi, const TfToken& primvarName, const UsdBridgeSettings& settings,
+    const std::set<SdfPath>& fullPrecisionAttribs)
+  {
+    return settings.EnableQuantization &&
+      !fullPrecisionAttribs.count(primvarApi.GetPath().AppendProperty(TfToken(SdfPath::JoinIdentifier("primvars", primvarName.GetString()))));
+  }
+
+  // Quantized attributes are written in half precision for as long as their data stays within the error bound. Data exceeding it
+  // is written in full precision instead, after the attribute has been promoted to full precision in all layers of the prim
+  // (see UsdBridgeUsdWriter::PromoteToFullPrecision), so samples written before keep matching the declared type.
+  // Returns whether writeHalf (taking the error bound) has written the data, otherwise the caller writes it in full precision.
+  template<typename WriteHalfFunc>
+  bool WriteQuantized(UsdBridgeUsdWriter* writer, const UsdBridgePrimCache* cacheEntry, const UsdAttribute& uniformAttrib, const UsdAttribute& outAttrib,
+    WriteHalfFunc writeHalf)
+  {
+    const UsdBridgeSettings& settings = writer->Settings;
+    if (!settings.EnableQuantization || !uniformAttrib || !IsHalfPrecisionType(uniformAttrib.GetTypeName()))
+      return false;
+
+    if (writeHalf(settings.QuantizationErrorBound))
+      return true;
+
+    writer->PromoteToFullPrecision(cacheEntry, uniformAttrib.GetPath(), outAttrib);
+    return false;
+  }
+
+  // Quantized normals go into the normals primvar, which takes precedence over the (single precision) normals attribute
+  template<typename UsdGeomType>
+  void CreateUsdGeomNormals(UsdGeomType& geom, UsdGeomPrimvarsAPI& primvarApi, const UsdBridgeSettings& settings, const std::set<SdfPath>& fullPrecisionAttribs)
+  {
+    if (settings.EnableQuantization)
+    {
+      bool halfPrecision = DeclaresHalfPrecision(primvarApi, UsdBridgeTokens->normals, settings, fullPrecisionAttribs);
+      primvarApi.CreatePrimvar(UsdBridgeTokens->normals, halfPrecision ? SdfValueTypeNames->Normal3hArray : SdfValueTypeNames->Normal3fArray);
+    }
+    else
+      geom.CreateNormalsAttr();
+  }
+
+  void RemoveUsdGeomNormals(UsdPrim& prim, UsdGeomPrimvarsAPI& primvarApi, const UsdBridgeSettings& settings)
+  {
+    if (settings.EnableQuantization)
+      primvarApi.RemovePrimvar(UsdBridgeTokens->normals);
+    else
+      prim.RemoveProperty(UsdBridgeTokens->normals);
+  }
+
+  template<typename UsdGeomType>
+  UsdAttribute GetUsdGeomNormalsAttr(UsdGeomType& geom, const UsdBridgeSettings& settings)
+  {
+    if (settings.EnableQuantization)
+      return UsdGeomPrimvarsAPI(geom).GetPrimvar(UsdBridgeTokens->normals).GetAttr();
+    return geom.GetNormalsAttr();
+  }
+
   template<typename GeomDataType>
-  void CreateUsdGeomColorPrimvars(UsdGeomPrimvarsAPI& primvarApi, const GeomDataType& geomData, const UsdBridgeSettings& settings, const TimeEvaluator<GeomDataType>* timeEval = nullptr)
+  void CreateUsdGeomColorPrimvars(UsdGeomPrimvarsAPI& primvarApi, const GeomDataType& geomData, const UsdBridgeSettings& settings, const std::set<SdfPath>& fullPrecisionAttribs,
+    const TimeEvaluator<GeomDataType>* timeEval = nullptr)
   {
     using DMI = typename GeomDataType::DataMemberId;
 
@@ -227,7 +531,8 @@ namespace
 
     if (timeVarChecked)
     {
-      primvarApi.CreatePrimvar(UsdBridgeTokens->color, SdfValueTypeNames->Color4fArray);
+      bool halfPrecision = DeclaresHalfPrecision(primvarApi, UsdBridgeTokens->color, settings, fullPrecisionAttribs);
+      primvarApi.CreatePrimvar(UsdBridgeTokens->color, halfPrecision ? SdfValueTypeNames->Color4hArray : SdfValueTypeNames->Color4fArray);
     }
     else
     {
@@ -253,7 +558,8 @@ namespace
   }
 
   template<typename GeomDataType>
-  void CreateUsdGeomAttributePrimvars(UsdGeomPrimvarsAPI& primvarApi, const GeomDataType& geomData, const TimeEvaluator<GeomDataType>* timeEval = nullptr)
+  void CreateUsdGeomAttributePrimvars(UsdGeomPrimvarsAPI& primvarApi, const GeomDataType& geomData, const UsdBridgeSettings& settings, const std::set<SdfPath>& fullPrecisionAttribs,
+    const TimeEvaluator<GeomDataType>* timeEval = nullptr)
   {
     using DMI = typename GeomDataType::DataMemberId;
 
@@ -271,8 +577,10 @@ namespace
 
         if(timeVarChecked)
         {
-          SdfValueTypeName primvarType = GetPrimvarArrayType(attrib.DataType);
-          primvarApi.CreatePrimvar(AttribIndexToToken(attribIndex), primvarType);
+          TfToken attribToken = AttribIndexToToken(attribIndex);
+          bool halfPrecision = DeclaresHalfPrecision(primvarApi, attribToken, settings, fullPrecisionAttribs);
+          SdfValueTypeName primvarType = GetPrimvarArrayType(halfPrecision ? GetQuantizedType(attrib.DataType) : attrib.DataType);
+          primvarApi.CreatePrimvar(attribToken, primvarType);
         }
         else if(timeEval)
         {
@@ -282,7 +590,7 @@ namespace
     }
   }
 
-  void InitializeUsdGeometryTimeVar(UsdGeomMesh& meshGeom, const UsdBridgeMeshData& meshData, const UsdBridgeSettings& settings, 
+  void InitializeUsdGeometryTimeVar(UsdGeomMesh& meshGeom, const UsdBridgeMeshData& meshData, const UsdBridgeSettings& settings, const std::set<SdfPath>& fullPrecisionAttribs,
     const TimeEvaluator<UsdBridgeMeshData>* timeEval = nullptr)
   {
     typedef UsdBridgeMeshData::DataMemberId DMI;
@@ -313,19 +621,19 @@ namespace
     }
 
     if (!timeEval || timeEval->IsTimeVarying(DMI::NORMALS))
-      meshGeom.CreateNormalsAttr();
+      CreateUsdGeomNormals(meshGeom, primvarApi, settings, fullPrecisionAttribs);
     else
-      meshPrim.RemoveProperty(UsdBridgeTokens->normals);
+      RemoveUsdGeomNormals(meshPrim, primvarApi, settings);
 
-    CreateUsdGeomColorPrimvars(primvarApi, meshData, settings, timeEval);
+    CreateUsdGeomColorPrimvars(primvarApi, meshData, settings, fullPrecisionAttribs, timeEval);
 
     if(settings.EnableStTexCoords)
       CreateUsdGeomTexturePrimvars(primvarApi, meshData, settings, timeEval);
 
-    CreateUsdGeomAttributePrimvars(primvarApi, meshData, timeEval);
+    CreateUsdGeomAttributePrimvars(primvarApi, meshData, settings, fullPrecisionAttribs, timeEval);
   }
   
-  void InitializeUsdGeometryTimeVar(UsdGeomPoints& pointsGeom, const UsdBridgeInstancerData& instancerData, const UsdBridgeSettings& settings,
+  void InitializeUsdGeometryTimeVar(UsdGeomPoints& pointsGeom, const UsdBridgeInstancerData& instancerData, const UsdBridgeSettings& settings, const std::set<SdfPath>& fullPrecisionAttribs,
     const TimeEvaluator<UsdBridgeInstancerData>* timeEval = nullptr)
   {
     typedef UsdBridgeInstancerData::DataMemberId DMI;
@@ -359,15 +667,15 @@ namespace
     else
       pointsPrim.RemoveProperty(UsdBridgeTokens->widths);
 
-    CreateUsdGeomColorPrimvars(primvarApi, instancerData, settings, timeEval);
+    CreateUsdGeomColorPrimvars(primvarApi, instancerData, settings, fullPrecisionAttribs, timeEval);
 
     if(settings.EnableStTexCoords)
       CreateUsdGeomTexturePrimvars(primvarApi, instancerData, settings, timeEval);
 
-    CreateUsdGeomAttributePrimvars(primvarApi, instancerData, timeEval);
+    CreateUsdGeomAttributePrimvars(primvarApi, instancerData, settings, fullPrecisionAttribs, timeEval);
   }
 
-  void InitializeUsdGeometryTimeVar(UsdGeomPointInstancer& pointsGeom, const UsdBridgeInstancerData& instancerData, const UsdBridgeSettings& settings,
+  void InitializeUsdGeometryTimeVar(UsdGeomPointInstancer& pointsGeom, const UsdBridgeInstancerData& instancerData, const UsdBridgeSettings& settings, const std::set<SdfPath>& fullPrecisionAttribs,
     const TimeEvaluator<UsdBridgeInstancerData>* timeEval = nullptr)
   {
     typedef UsdBridgeInstancerData::DataMemberId DMI;
@@ -406,12 +714,12 @@ namespace
     else
       pointsPrim.RemoveProperty(UsdBridgeTokens->scales);
 
-    CreateUsdGeomColorPrimvars(primvarApi, instancerData, settings, timeEval);
+    CreateUsdGeomColorPrimvars(primvarApi, instancerData, settings, fullPrecisionAttribs, timeEval);
 
     if(settings.EnableStTexCoords)
       CreateUsdGeomTexturePrimvars(primvarApi, instancerData, settings, timeEval);
 
-    CreateUsdGeomAttributePrimvars(primvarApi, instancerData, timeEval);
+    CreateUsdGeomAttributePrimvars(primvarApi, instancerData, settings, fullPrecisionAttribs, timeEval);
 
     if (!timeEval || timeEval->IsTimeVarying(DMI::LINEARVELOCITIES))
       pointsGeom.CreateVelocitiesAttr();
@@ -429,7 +737,7 @@ namespace
       pointsPrim.RemoveProperty(UsdBridgeTokens->invisibleIds);
   }
 
-  void InitializeUsdGeometryTimeVar(UsdGeomBasisCurves& curveGeom, const UsdBridgeCurveData& curveData, const UsdBridgeSettings& settings,
+  void InitializeUsdGeometryTimeVar(UsdGeomBasisCurves& curveGeom, const UsdBridgeCurveData& curveData, const UsdBridgeSettings& settings, const std::set<SdfPath>& fullPrecisionAttribs,
     const TimeEvaluator<UsdBridgeCurveData>* timeEval = nullptr)
   {
     typedef UsdBridgeCurveData::DataMemberId DMI;
@@ -454,31 +762,31 @@ namespace
       curvePrim.RemoveProperty(UsdBridgeTokens->curveVertexCounts);
 
     if (!timeEval || timeEval->IsTimeVarying(DMI::NORMALS))
-      curveGeom.CreateNormalsAttr();
+      CreateUsdGeomNormals(curveGeom, primvarApi, settings, fullPrecisionAttribs);
     else
-      curvePrim.RemoveProperty(UsdBridgeTokens->normals);
+      RemoveUsdGeomNormals(curvePrim, primvarApi, settings);
 
     if (!timeEval || timeEval->IsTimeVarying(DMI::SCALES))
       curveGeom.CreateWidthsAttr();
     else
       curvePrim.RemoveProperty(UsdBridgeTokens->widths);
 
-    CreateUsdGeomColorPrimvars(primvarApi, curveData, settings, timeEval);
+    CreateUsdGeomColorPrimvars(primvarApi, curveData, settings, fullPrecisionAttribs, timeEval);
 
     if(settings.EnableStTexCoords)
       CreateUsdGeomTexturePrimvars(primvarApi, curveData, settings, timeEval);
 
-    CreateUsdGeomAttributePrimvars(primvarApi, curveData, timeEval);
+    CreateUsdGeomAttributePrimvars(primvarApi, curveData, settings, fullPrecisionAttribs, timeEval);
 
   }
 
   UsdPrim InitializeUsdGeometry_Impl(UsdStageRefPtr geometryStage, const SdfPath& geomPath, const UsdBridgeMeshData& meshData, bool uniformPrim,
-    const UsdBridgeSettings& settings,
+    const UsdBridgeSettings& settings, const std::set<SdfPath>& fullPrecisionAttribs,
     TimeEvaluator<UsdBridgeMeshData>* timeEval = nullptr)
   {
     UsdGeomMesh geomMesh = GetOrDefinePrim<UsdGeomMesh>(geometryStage, geomPath);
     
-    InitializeUsdGeometryTimeVar(geomMesh, meshData, settings, timeEval);
+    InitializeUsdGeometryTimeVar(geomMesh, meshData, settings, fullPrecisionAttribs, timeEval);
 
     if (uniformPrim)
     {
@@ -490,14 +798,14 @@ namespace
   }
 
   UsdPrim InitializeUsdGeometry_Impl(UsdStageRefPtr geometryStage, const SdfPath& geomPath, const UsdBridgeInstancerData& instancerData, bool uniformPrim,
-    const UsdBridgeSettings& settings,
+    const UsdBridgeSettings& settings, const std::set<SdfPath>& fullPrecisionAttribs,
     TimeEvaluator<UsdBridgeInstancerData>* timeEval = nullptr)
   {
     if (UsesUsdGeomPoints(instancerData))
     {
       UsdGeomPoints geomPoints = GetOrDefinePrim<UsdGeomPoints>(geometryStage, geomPath);
       
-      InitializeUsdGeometryTimeVar(geomPoints, instancerData, settings, timeEval);
+      InitializeUsdGeometryTimeVar(geomPoints, instancerData, settings, fullPrecisionAttribs, timeEval);
 
       if (uniformPrim)
       {
@@ -510,7 +818,7 @@ namespace
     {
       UsdGeomPointInstancer geomPoints = GetOrDefinePrim<UsdGeomPointInstancer>(geometryStage, geomPath);
       
-      InitializeUsdGeometryTimeVar(geomPoints, instancerData, settings, timeEval);
+      InitializeUsdGeometryTimeVar(geomPoints, instancerData, settings, fullPrecisionAttribs, timeEval);
 
       if (uniformPrim)
       {
@@ -547,12 +855,12 @@ namespace
   }
 
   UsdPrim InitializeUsdGeometry_Impl(UsdStageRefPtr geometryStage, const SdfPath& geomPath, const UsdBridgeCurveData& curveData, bool uniformPrim,
-    const UsdBridgeSettings& settings,
+    const UsdBridgeSettings& settings, const std::set<SdfPath>& fullPrecisionAttribs,
     TimeEvaluator<UsdBridgeCurveData>* timeEval = nullptr)
   {
     UsdGeomBasisCurves geomCurves = GetOrDefinePrim<UsdGeomBasisCurves>(geometryStage, geomPath);
 
-    InitializeUsdGeometryTimeVar(geomCurves, curveData, settings, timeEval);
+    InitializeUsdGeometryTimeVar(geomCurves, curveData, settings, fullPrecisionAttribs, timeEval);
 
     if (uniformPrim)
     {
@@ -563,6 +871,27 @@ namespace
     return geomCurves.GetPrim();
   }
 
+  bool ComputeGeomExtent(const UsdBridgeMeshData& geomData, UsdBridgeExtent& extent)
+  {
+    return UsdBridgeComputeExtent(geomData.Points, geomData.PointsType, geomData.NumPoints, nullptr, UsdBridgeType::UNDEFINED, 0.0, extent);
+  }
+
+  bool ComputeGeomExtent(const UsdBridgeInstancerData& geomData, UsdBridgeExtent& extent)
+  {
+    // Only UsdGeomPoints have widths, the extent of a point instancer covers its positions
+    if (UsesUsdGeomPoints(geomData) && 
+      UsdBridgeComputeExtent(geomData.Points, geomData.PointsType, geomData.NumPoints, geomData.Scales, geomData.ScalesType, geomData.UniformScale, extent))
+      return true;
+    return UsdBridgeComputeExtent(geomData.Points, geomData.PointsType, geomData.NumPoints, nullptr, UsdBridgeType::UNDEFINED, 0.0, extent);
+  }
+
+  bool ComputeGeomExtent(const UsdBridgeCurveData& geomData, UsdBridgeExtent& extent)
+  {
+    if (UsdBridgeComputeExtent(geomData.Points, geomData.PointsType, geomData.NumPoints, geomData.Scales, geomData.ScalesType, geomData.UniformScale, extent))
+      return true;
+    return UsdBridgeComputeExtent(geomData.Points, geomData.PointsType, geomData.NumPoints, nullptr, UsdBridgeType::UNDEFINED, 0.0, extent);
+  }
+
   template<typename UsdGeomType, typename GeomDataType>
   void UpdateUsdGeomPoints(UsdBridgeUsdWriter* writer, UsdGeomType& timeVarGeom, UsdGeomType& uniformGeom, const GeomDataType& geomData, uint64_t numPrims,
     UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval)
@@ -601,105 +930,180 @@ namespace
 
         // Usd requires extent.
         GfRange3f extent;
-        for (const auto& pt : usdVerts) {
-          extent.UnionWith(pt);
-        }
+        UsdBridgeExtent geomExtent;
+        if (ComputeGeomExtent(geomData, geomExtent))
+          extent = GfRange3f(GfVec3f(geomExtent.Min), GfVec3f(geomExtent.Max));
         VtVec3fArray extentArray(2);
         extentArray[0] = extent.GetMin();
         extentArray[1] = extent.GetMax();
 
-        outGeom->GetExtentAttr().Set(extentArray, timeCode);
+        SetAttributeValue(writer, outGeom->GetExtentAttr(), extentArray, timeCode);
       }
     }
   }
 
-  template<typename UsdGeomType, typename GeomDataType>
-  void UpdateUsdGeomIndices(UsdBridgeUsdWriter* writer, UsdGeomType& timeVarGeom, UsdGeomType& uniformGeom, const GeomDataType& geomData, uint64_t numPrims,
-    UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval)
+  UsdBridgeMeshTopology GetMeshTopology(const UsdBridgeMeshData& geomData, uint64_t numPrims)
   {
-    using DMI = typename GeomDataType::DataMemberId;
+    UsdBridgeMeshTopology topology;
+    topology.NumFaces = numPrims;
+    topology.FaceVertexCount = geomData.FaceVertexCount;
+    if (geomData.Indices)
+      topology.IndexHash = UsdBridgeHashData(geomData.Indices, geomData.NumIndices*UsdBridgeTypeSize(geomData.IndicesType), 
+        static_cast<uint64_t>(geomData.IndicesType)+1);
+    topology.Authored = true;
+    return topology;
+  }
+
+  void WriteUsdGeomTopology(UsdBridgeUsdWriter* writer, UsdAttribute faceVertCountsAttr, UsdAttribute arrayPrimvar, 
+    const UsdBridgeMeshData& geomData, uint64_t numPrims, UsdTimeCode timeCode)
+  {
+    uint64_t numIndices = geomData.NumIndices;
+  
+    VtArray<int>& usdVertexCounts = GetStaticTempArray<VtArray<int>>();
+    usdVertexCounts.resize(numPrims);
+    int vertexCount = numIndices / numPrims;
+    for (uint64_t i = 0; i < numPrims; ++i)
+      usdVertexCounts[i] = vertexCount;//geomData.FaceVertCounts[i];
+
+    // Face Vertex counts
+    SetAttributeValue(writer, faceVertCountsAttr, usdVertexCounts, timeCode);
+
+    if (!geomData.Indices)
+    {
+      writer->TempIndexArray.resize(numIndices);
+      for (uint64_t i = 0; i < numIndices; ++i)
+        writer->TempIndexArray[i] = (int)i;
+
+      SetAttributeValue(writer, arrayPrimvar, writer->TempIndexArray, timeCode);
+    }
+    else
+    {
+      // Face indices
+      const void* arrayData = geomData.Indices;
+      size_t arrayNumElements = numIndices;
+      switch (geomData.IndicesType)
+      {
+      case UsdBridgeType::ULONG: {ASSIGN_PRIMVAR_CONVERT_MACRO(VtIntArray, uint64_t); break; }
+      case UsdBridgeType::LONG: {ASSIGN_PRIMVAR_CONVERT_MACRO(VtIntArray, int64_t); break; }
+      case UsdBridgeType::INT: {ASSIGN_PRIMVAR_MACRO(VtIntArray); break; }
+      case UsdBridgeType::UINT: {ASSIGN_PRIMVAR_MACRO(VtIntArray); break; }
+      default: { UsdBridgeLogMacro(writer, UsdBridgeLogLevel::ERR, "UsdGeom FaceVertexIndicesAttr should be (U)LONG or (U)INT."); break; }
+      }
+    }
+  }
+
+  void UpdateUsdGeomIndices(UsdBridgeUsdWriter* writer, UsdGeomMesh& timeVarGeom, UsdGeomMesh& uniformGeom, const UsdBridgeMeshData& geomData, uint64_t numPrims,
+    UsdBridgeUpdateEvaluator<const UsdBridgeMeshData>& updateEval, TimeEvaluator<UsdBridgeMeshData>& timeEval, UsdBridgePrimCache* cacheEntry)
+  {
+    using DMI = UsdBridgeMeshData::DataMemberId;
     bool performsUpdate = updateEval.PerformsUpdate(DMI::INDICES);
     bool timeVaryingUpdate = timeEval.IsTimeVarying(DMI::INDICES);
 
+    // Topology is compared by hash against what was last authored for the prim
+    UsdBridgeMeshTopologyCache* topologyCache = nullptr;
+    UsdBridgeMeshTopology topology;
+    if (performsUpdate && cacheEntry)
+    {
+      topologyCache = &cacheEntry->MeshTopologies[uniformGeom.GetPath()];
+      topology = GetMeshTopology(geomData, numPrims);
+
+      // Any timevarying update since the uniform value was written resets it, so nothing has to be cleared either
+      if (!timeVaryingUpdate && topologyCache->Uniform == topology)
+        return;
+    }
+
     ClearUsdAttributes(uniformGeom.GetFaceVertexIndicesAttr(), timeVarGeom.GetFaceVertexIndicesAttr(), timeVaryingUpdate);
     ClearUsdAttributes(uniformGeom.GetFaceVertexCountsAttr(), timeVarGeom.GetFaceVertexCountsAttr(), timeVaryingUpdate);
 
     if (performsUpdate)
     {
-      UsdGeomType* outGeom = timeVaryingUpdate ? &timeVarGeom : &uniformGeom;
       UsdTimeCode timeCode = timeEval.Eval(DMI::INDICES);
 
-      uint64_t numIndices = geomData.NumIndices;
-    
-      VtArray<int>& usdVertexCounts = GetStaticTempArray<VtArray<int>>();
-      usdVertexCounts.resize(numPrims);
-      int vertexCount = numIndices / numPrims;
-      for (uint64_t i = 0; i < numPrims; ++i)
-        usdVertexCounts[i] = vertexCount;//geomData.FaceVertCounts[i];
-
-      // Face Vertex counts
-      UsdAttribute faceVertCountsAttr = outGeom->GetFaceVertexCountsAttr();
-      faceVertCountsAttr.Set(usdVertexCounts, timeCode);
-
-      if (!geomData.Indices)
-      {
-        writer->TempIndexArray.resize(numIndices);
-        for (uint64_t i = 0; i < numIndices; ++i)
-          writer->TempIndexArray[i] = (int)i;
-
-        UsdAttribute arrayPrimvar = outGeom->GetFaceVertexIndicesAttr();
-        arrayPrimvar.Set(writer->TempIndexArray, timeCode);
-      }
-      else
+      if (topologyCache)
       {
-        // Face indices
-        const void* arrayData = geomData.Indices;
-        size_t arrayNumElements = numIndices;
-        UsdAttribute arrayPrimvar = outGeom->GetFaceVertexIndicesAttr();
-        switch (geomData.IndicesType)
+        if (timeVaryingUpdate)
         {
-        case UsdBridgeType::ULONG: {ASSIGN_PRIMVAR_CONVERT_MACRO(VtIntArray, uint64_t); break; }
-        case UsdBridgeType::LONG: {ASSIGN_PRIMVAR_CONVERT_MACRO(VtIntArray, int64_t); break; }
-        case UsdBridgeType::INT: {ASSIGN_PRIMVAR_MACRO(VtIntArray); break; }
-        case UsdBridgeType::UINT: {ASSIGN_PRIMVAR_MACRO(VtIntArray); break; }
-        default: { UsdBridgeLogMacro(writer, UsdBridgeLogLevel::ERR, "UsdGeom FaceVertexIndicesAttr should be (U)LONG or (U)INT."); break; }
+          topologyCache->Uniform = UsdBridgeMeshTopology();
+
+#if defined(VALUE_CLIP_RETIMING) && defined(TIME_CLIP_STAGES)
+          // The first timevarying topology becomes the manifest default, which clip stages without samples of their own fall back to.
+          // Deforming meshes then write their topology once, instead of into every clip stage.
+          UsdGeomMesh manifestGeom = UsdGeomMesh::Get(cacheEntry->ManifestStage.second, uniformGeom.GetPath());
+          UsdAttribute manifestCountsAttr = manifestGeom ? manifestGeom.GetFaceVertexCountsAttr() : UsdAttribute();
+          UsdAttribute manifestIndicesAttr = manifestGeom ? manifestGeom.GetFaceVertexIndicesAttr() : UsdAttribute();
+          if (manifestCountsAttr && manifestIndicesAttr)
+          {
+            // Manifest attributes are removed and recreated when the indices alternate between uniform and timevarying.
+            // A default of unknown origin is left alone, as earlier clip stages may depend on it.
+            if (topologyCache->Shared.Authored && !manifestIndicesAttr.HasAuthoredValue())
+              topologyCache->Shared = UsdBridgeMeshTopology();
+            if (!topologyCache->Shared.Authored && !manifestIndicesAttr.HasAuthoredValue())
+            {
+              WriteUsdGeomTopology(writer, manifestCountsAttr, manifestIndicesAttr, geomData, numPrims, UsdTimeCode::Default());
+              topologyCache->Shared = topology;
+            }
+
+            if (topologyCache->Shared == topology)
+            {
+              timeVarGeom.GetFaceVertexCountsAttr().ClearAtTime(timeCode);
+              timeVarGeom.GetFaceVertexIndicesAttr().ClearAtTime(timeCode);
+              return;
+            }
+          }
+#endif
         }
+        else
+          topologyCache->Uniform = topology;
       }
+
+      UsdGeomMesh* outGeom = timeVaryingUpdate ? &timeVarGeom : &uniformGeom;
+      WriteUsdGeomTopology(writer, outGeom->GetFaceVertexCountsAttr(), outGeom->GetFaceVertexIndicesAttr(), geomData, numPrims, timeCode);
     }
   }
 
   template<typename UsdGeomType, typename GeomDataType>
   void UpdateUsdGeomNormals(UsdBridgeUsdWriter* writer, UsdGeomType& timeVarGeom, UsdGeomType& uniformGeom, const GeomDataType& geomData, uint64_t numPrims,
-    UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval)
+    UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval, const UsdBridgePrimCache* cacheEntry)
   {
     using DMI = typename GeomDataType::DataMemberId;
     bool performsUpdate = updateEval.PerformsUpdate(DMI::NORMALS);
     bool timeVaryingUpdate = timeEval.IsTimeVarying(DMI::NORMALS);
 
-    ClearUsdAttributes(uniformGeom.GetNormalsAttr(), timeVarGeom.GetNormalsAttr(), timeVaryingUpdate);
+    const UsdBridgeSettings& settings = writer->Settings;
+    UsdAttribute uniformNormalsAttr = GetUsdGeomNormalsAttr(uniformGeom, settings);
+    UsdAttribute timeVarNormalsAttr = GetUsdGeomNormalsAttr(timeVarGeom, settings);
+
+    ClearUsdAttributes(uniformNormalsAttr, timeVarNormalsAttr, timeVaryingUpdate);
 
     if (performsUpdate)
     {
-      UsdGeomType* outGeom = timeVaryingUpdate ? &timeVarGeom : &uniformGeom;
       UsdTimeCode timeCode = timeEval.Eval(DMI::NORMALS);
 
-      UsdAttribute normalsAttr = outGeom->GetNormalsAttr();
+      UsdAttribute normalsAttr = timeVaryingUpdate ? timeVarNormalsAttr : uniformNormalsAttr;
 
       if (geomData.Normals != nullptr)
       {
         const void* arrayData = geomData.Normals;
         size_t arrayNumElements = geomData.PerPrimNormals ? numPrims : geomData.NumPoints;
         UsdAttribute arrayPrimvar = normalsAttr;
-        switch (geomData.NormalsType)
+        bool quantized = WriteQuantized(writer, cacheEntry, uniformNormalsAttr, arrayPrimvar, [&](double errorBound)
+          { return AssignNormalsToHalfPrimvar(writer, arrayData, geomData.NormalsType, arrayNumElements, errorBound, arrayPrimvar, timeCode); });
+        if (!quantized)
         {
-        case UsdBridgeType::FLOAT3: {ASSIGN_PRIMVAR_MACRO(VtVec3fArray); break; }
-        case UsdBridgeType::DOUBLE3: {ASSIGN_PRIMVAR_CONVERT_MACRO(VtVec3fArray, GfVec3d); break; }
-        default: { UsdBridgeLogMacro(writer, UsdBridgeLogLevel::ERR, "UsdGeom NormalsAttr should be FLOAT3 or DOUBLE3."); break; }
+          switch (geomData.NormalsType)
+          {
+          case UsdBridgeType::FLOAT3: {ASSIGN_PRIMVAR_MACRO(VtVec3fArray); break; }
+          case UsdBridgeType::DOUBLE3: {ASSIGN_PRIMVAR_CONVERT_MACRO(VtVec3fArray, GfVec3d); break; }
+          default: { UsdBridgeLogMacro(writer, UsdBridgeLogLevel::ERR, "UsdGeom NormalsAttr should be FLOAT3 or DOUBLE3."); break; }
+          }
         }
 
         // Per face or per-vertex interpolation. This will break timesteps that have been written before.
         TfToken normalInterpolation = geomData.PerPrimNormals ? UsdGeomTokens->uniform : UsdGeomTokens->vertex;
-        uniformGeom.SetNormalsInterpolation(normalInterpolation);
+        if (settings.EnableQuantization)
+          UsdGeomPrimvar(uniformNormalsAttr).SetInterpolation(normalInterpolation);
+        else
+          uniformGeom.SetNormalsInterpolation(normalInterpolation);
       }
       else
       {
@@ -756,7 +1160,7 @@ namespace
 
   template<typename UsdGeomType, typename GeomDataType>
   void UpdateUsdGeomAttribute(UsdBridgeUsdWriter* writer, UsdGeomPrimvarsAPI& timeVarPrimvars, UsdGeomType& uniformPrimvars, const GeomDataType& geomData, uint64_t numPrims,
-    UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval, uint32_t attribIndex)
+    UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval, const UsdBridgePrimCache* cacheEntry, uint32_t attribIndex)
   {
     assert(attribIndex < geomData.NumAttributes);
     const UsdBridgeAttribute& bridgeAttrib = geomData.Attributes[attribIndex];
@@ -788,12 +1192,26 @@ namespace
         {
           const void* arrayData = bridgeAttrib.Data;
           size_t arrayNumElements = bridgeAttrib.PerPrimData ? numPrims : geomData.NumPoints;
+          TfToken attribInterpolation = bridgeAttrib.PerPrimData ? UsdGeomTokens->uniform : UsdGeomTokens->vertex;
+          ReduceToConstantPrimvar(arrayData, bridgeAttrib.DataType, timeVaryingUpdate, arrayNumElements, attribInterpolation);
           UsdAttribute arrayPrimvar = attributePrimvar;
 
-          CopyArrayToPrimvar(writer, arrayData, bridgeAttrib.DataType, arrayNumElements, arrayPrimvar, timeCode);
+          const UsdBridgeSettings& settings = writer->Settings;
+          std::vector<char> indexedValues;
+          VtIntArray valueIndices;
+          bool halfOutput = settings.EnableQuantization && IsHalfPrecisionType(uniformPrimvar.GetAttr().GetTypeName());
+          size_t outputElementSize = UsdBridgeTypeSize(halfOutput ? GetQuantizedType(bridgeAttrib.DataType) : bridgeAttrib.DataType);
+          bool indexed = IndexPrimvarValues(settings, arrayData, bridgeAttrib.DataType, outputElementSize, timeVaryingUpdate, arrayNumElements,
+            indexedValues, valueIndices);
+
+          bool quantized = (GetQuantizedType(bridgeAttrib.DataType) != bridgeAttrib.DataType)
+            && WriteQuantized(writer, cacheEntry, uniformPrimvar.GetAttr(), arrayPrimvar, [&](double errorBound)
+              { return AssignAttributeToHalfPrimvar(writer, arrayData, bridgeAttrib.DataType, arrayNumElements, errorBound, arrayPrimvar, timeCode); });
+          if (!quantized)
+            CopyArrayToPrimvar(writer, arrayData, bridgeAttrib.DataType, arrayNumElements, arrayPrimvar, timeCode);
+          UpdatePrimvarIndices(uniformPrimvar, indexed, valueIndices);
     
           // Per face or per-vertex interpolation. This will break timesteps that have been written before.
-          TfToken attribInterpolation = bridgeAttrib.PerPrimData ? UsdGeomTokens->uniform : UsdGeomTokens->vertex;
           uniformPrimvar.SetInterpolation(attribInterpolation);
         }
         else
@@ -806,20 +1224,20 @@ namespace
 
   template<typename UsdGeomType, typename GeomDataType>
   void UpdateUsdGeomAttributes(UsdBridgeUsdWriter* writer, UsdGeomPrimvarsAPI& timeVarPrimvars, UsdGeomType& uniformPrimvars, const GeomDataType& geomData, uint64_t numPrims,
-    UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval)
+    UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval, const UsdBridgePrimCache* cacheEntry)
   {
     uint32_t startIdx = 0;
     for(uint32_t attribIndex = startIdx; attribIndex < geomData.NumAttributes; ++attribIndex)
     {
       const UsdBridgeAttribute& attrib = geomData.Attributes[attribIndex];
       if(attrib.DataType != UsdBridgeType::UNDEFINED)
-        UpdateUsdGeomAttribute(writer, timeVarPrimvars, uniformPrimvars, geomData, numPrims, updateEval, timeEval, attribIndex);
+        UpdateUsdGeomAttribute(writer, timeVarPrimvars, uniformPrimvars, geomData, numPrims, updateEval, timeEval, cacheEntry, attribIndex);
     }
   }
 
   template<typename UsdGeomType, typename GeomDataType>
   void UpdateUsdGeomColors(UsdBridgeUsdWriter* writer, UsdGeomPrimvarsAPI& timeVarPrimvars, UsdGeomType& uniformPrimvars, const GeomDataType& geomData, uint64_t numPrims,
-    UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval)
+    UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval, const UsdBridgePrimCache* cacheEntry)
   {
     using DMI = typename GeomDataType::DataMemberId;
     bool performsUpdate = updateEval.PerformsUpdate(DMI::COLORS);
@@ -841,35 +1259,51 @@ namespace
         const void* arrayData = geomData.Colors;
         size_t arrayNumElements = geomData.PerPrimColors ? numPrims : geomData.NumPoints;
         TfToken colorInterpolation = geomData.PerPrimColors ? UsdGeomTokens->uniform : UsdGeomTokens->vertex;
+        ReduceToConstantPrimvar(arrayData, geomData.ColorsType, timeVaryingUpdate, arrayNumElements, colorInterpolation);
 
         assert(colorPrimvar);
 
         UsdAttribute arrayPrimvar = colorPrimvar;
-        switch (geomData.ColorsType)
+        const UsdBridgeSettings& settings = writer->Settings;
+        std::vector<char> indexedValues;
+        VtIntArray valueIndices;
+        bool halfOutput = settings.EnableQuantization && IsHalfPrecisionType(uniformDispPrimvar.GetAttr().GetTypeName());
+        size_t outputElementSize = halfOutput ? sizeof(GfVec4h) : sizeof(GfVec4f);
+        bool indexed = IndexPrimvarValues(settings, arrayData, geomData.ColorsType, outputElementSize, timeVaryingUpdate, arrayNumElements,
+          indexedValues, valueIndices);
+
+        bool quantized = WriteQuantized(writer, cacheEntry, uniformDispPrimvar.GetAttr(), arrayPrimvar, [&](double errorBound)
+          { return AssignColorsToHalfPrimvar(writer, arrayData, geomData.ColorsType, arrayNumElements, errorBound, arrayPrimvar, timeCode); });
+        if (!quantized)
         {
-        case UsdBridgeType::UCHAR: {ASSIGN_PRIMVAR_MACRO_1EXPAND_NORMALIZE_COL(uint8_t); break; }
-        case UsdBridgeType::UCHAR2: {ASSIGN_PRIMVAR_MACRO_2EXPAND_NORMALIZE_COL(uint8_t); break; }
-        case UsdBridgeType::UCHAR3: {ASSIGN_PRIMVAR_MACRO_3EXPAND_NORMALIZE_COL(uint8_t); break; }
-        case UsdBridgeType::UCHAR4: {ASSIGN_PRIMVAR_MACRO_4EXPAND_NORMALIZE_COL(uint8_t); break; }
-        case UsdBridgeType::USHORT: {ASSIGN_PRIMVAR_MACRO_1EXPAND_NORMALIZE_COL(uint16_t); break; }
-        case UsdBridgeType::USHORT2: {ASSIGN_PRIMVAR_MACRO_2EXPAND_NORMALIZE_COL(uint16_t); break; }
-        case UsdBridgeType::USHORT3: {ASSIGN_PRIMVAR_MACRO_3EXPAND_NORMALIZE_COL(uint16_t); break; }
-        case UsdBridgeType::USHORT4: {ASSIGN_PRIMVAR_MACRO_4EXPAND_NORMALIZE_COL(uint16_t); break; }
-        case UsdBridgeType::UINT: {ASSIGN_PRIMVAR_MACRO_1EXPAND_NORMALIZE_COL(uint32_t); break; }
-        case UsdBridgeType::UINT2: {ASSIGN_PRIMVAR_MACRO_2EXPAND_NORMALIZE_COL(uint32_t); break; }
-        case UsdBridgeType::UINT3: {ASSIGN_PRIMVAR_MACRO_3EXPAND_NORMALIZE_COL(uint32_t); break; }
-        case UsdBridgeType::UINT4: {ASSIGN_PRIMVAR_MACRO_4EXPAND_NORMALIZE_COL(uint32_t); break; }
-        case UsdBridgeType::FLOAT: {ASSIGN_PRIMVAR_MACRO_1EXPAND_COL(float); break; }
-        case UsdBridgeType::FLOAT2: {ASSIGN_PRIMVAR_MACRO_2EXPAND_COL(float); break; }
-        case UsdBridgeType::FLOAT3: {ASSIGN_PRIMVAR_MACRO_3EXPAND_COL(float); break; }
-        case UsdBridgeType::FLOAT4: {ASSIGN_PRIMVAR_MACRO(VtVec4fArray); break; }
-        case UsdBridgeType::DOUBLE: {ASSIGN_PRIMVAR_MACRO_1EXPAND_COL(double) break; }
-        case UsdBridgeType::DOUBLE2: {ASSIGN_PRIMVAR_MACRO_2EXPAND_COL(double); break; }
-        case UsdBridgeType::DOUBLE3: {ASSIGN_PRIMVAR_MACRO_3EXPAND_COL(double); break; }
-        case UsdBridgeType::DOUBLE4: {ASSIGN_PRIMVAR_CONVERT_MACRO(VtVec4fArray, GfVec4d); break; }
-        default: { UsdBridgeLogMacro(writer, UsdBridgeLogLevel::ERR, "UsdGeom color primvar is not of type (UCHAR/USHORT/UINT/FLOAT/DOUBLE)(1/2/3/4)."); break; }
+          switch (geomData.ColorsType)
+          {
+          case UsdBridgeType::UCHAR: {ASSIGN_PRIMVAR_MACRO_1EXPAND_NORMALIZE_COL(uint8_t); break; }
+          case UsdBridgeType::UCHAR2: {ASSIGN_PRIMVAR_MACRO_2EXPAND_NORMALIZE_COL(uint8_t); break; }
+          case UsdBridgeType::UCHAR3: {ASSIGN_PRIMVAR_MACRO_3EXPAND_NORMALIZE_COL(uint8_t); break; }
+          case UsdBridgeType::UCHAR4: {ASSIGN_PRIMVAR_MACRO_4EXPAND_NORMALIZE_COL(uint8_t); break; }
+          case UsdBridgeType::USHORT: {ASSIGN_PRIMVAR_MACRO_1EXPAND_NORMALIZE_COL(uint16_t); break; }
+          case UsdBridgeType::USHORT2: {ASSIGN_PRIMVAR_MACRO_2EXPAND_NORMALIZE_COL(uint16_t); break; }
+          case UsdBridgeType::USHORT3: {ASSIGN_PRIMVAR_MACRO_3EXPAND_NORMALIZE_COL(uint16_t); break; }
+          case UsdBridgeType::USHORT4: {ASSIGN_PRIMVAR_MACRO_4EXPAND_NORMALIZE_COL(uint16_t); break; }
+          case UsdBridgeType::UINT: {ASSIGN_PRIMVAR_MACRO_1EXPAND_NORMALIZE_COL(uint32_t); break; }
+          case UsdBridgeType::UINT2: {ASSIGN_PRIMVAR_MACRO_2EXPAND_NORMALIZE_COL(uint32_t); break; }
+          case UsdBridgeType::UINT3: {ASSIGN_PRIMVAR_MACRO_3EXPAND_NORMALIZE_COL(uint32_t); break; }
+          case UsdBridgeType::UINT4: {ASSIGN_PRIMVAR_MACRO_4EXPAND_NORMALIZE_COL(uint32_t); break; }
+          case UsdBridgeType::FLOAT: {ASSIGN_PRIMVAR_MACRO_1EXPAND_COL(float); break; }
+          case UsdBridgeType::FLOAT2: {ASSIGN_PRIMVAR_MACRO_2EXPAND_COL(float); break; }
+          case UsdBridgeType::FLOAT3: {ASSIGN_PRIMVAR_MACRO_3EXPAND_COL(float); break; }
+          case UsdBridgeType::FLOAT4: {ASSIGN_PRIMVAR_MACRO(VtVec4fArray); break; }
+          case UsdBridgeType::DOUBLE: {ASSIGN_PRIMVAR_MACRO_1EXPAND_COL(double) break; }
+          case UsdBridgeType::DOUBLE2: {ASSIGN_PRIMVAR_MACRO_2EXPAND_COL(double); break; }
+          case UsdBridgeType::DOUBLE3: {ASSIGN_PRIMVAR_MACRO_3EXPAND_COL(double); break; }
+          case UsdBridgeType::DOUBLE4: {ASSIGN_PRIMVAR_CONVERT_MACRO(VtVec4fArray, GfVec4d); break; }
+          default: { UsdBridgeLogMacro(writer, UsdBridgeLogLevel::ERR, "UsdGeom color primvar is not of type (UCHAR/USHORT/UINT/FLOAT/DOUBLE)(1/2/3/4)."); break; }
+          }
         }
 
+        UpdatePrimvarIndices(uniformDispPrimvar, indexed, valueIndices);
+
         // Per face or per-vertex interpolation. This will break timesteps that have been written before.
         uniformDispPrimvar.SetInterpolation(colorInterpolation);
       }
@@ -953,7 +1387,7 @@ namespace
         VtFloatArray& usdWidths = GetStaticTempArray<VtFloatArray>();
         usdWidths.resize(geomData.NumPoints);
         for(auto& x : usdWidths) x = (float)geomData.UniformScale;
-        widthsAttribute.Set(usdWidths, timeCode);
+        SetAttributeValue(writer, widthsAttribute, usdWidths, timeCode);
       }
     }
   }
@@ -996,7 +1430,7 @@ namespace
         VtVec3fArray& usdScales = GetStaticTempArray<VtVec3fArray>();
         usdScales.resize(geomData.NumPoints);
         for(auto& x : usdScales) x = defaultScale;
-        scalesAttribute.Set(usdScales, timeCode);
+        SetAttributeValue(writer, scalesAttribute, usdScales, timeCode);
       }
     }
   }
@@ -1037,7 +1471,7 @@ namespace
         VtVec3fArray& usdNormals = GetStaticTempArray<VtVec3fArray>();
         usdNormals.resize(geomData.NumPoints);
         for(auto& x : usdNormals) x = defaultNormal;
-        normalsAttribute.Set(usdNormals, timeCode);
+        SetAttributeValue(writer, normalsAttribute, usdNormals, timeCode);
       }
     }
   }
@@ -1075,12 +1509,12 @@ namespace
               const float* orients = reinterpret_cast<const float*>(geomData.Orientations);
               usdOrients[i] = GfQuath(orients[i * 4], orients[i * 4 + 1], orients[i * 4 + 2], orients[i * 4 + 3]);
             }
-            orientationsAttribute.Set(usdOrients, timeCode);
+            SetAttributeValue(writer, orientationsAttribute, usdOrients, timeCode);
             break; 
           }
         default: { UsdBridgeLogMacro(writer, UsdBridgeLogLevel::ERR, "UsdGeom OrientationsAttribute should be FLOAT3, DOUBLE3 or FLOAT4."); break; }
         }
-        orientationsAttribute.Set(usdOrients, timeCode);
+        SetAttributeValue(writer, orientationsAttribute, usdOrients, timeCode);
       }
       else
       {
@@ -1088,7 +1522,7 @@ namespace
         GfQuath defaultOrient(1, 0, 0, 0);
         usdOrients.resize(geomData.NumPoints);
         for(auto& x : usdOrients) x = defaultOrient;
-        orientationsAttribute.Set(usdOrients, timeCode);
+        SetAttributeValue(writer, orientationsAttribute, usdOrients, timeCode);
       }
     }
   }
@@ -1107,7 +1541,7 @@ namespace
     VtIntArray& protoIndices = GetStaticTempArray<VtIntArray>();
     protoIndices.resize(geomData.NumPoints);
     for(auto& x : protoIndices) x = 0;
-    protoIndexAttr.Set(protoIndices, timeCode);
+    SetAttributeValue(writer, protoIndexAttr, protoIndices, timeCode);
   }
 
   template<typename UsdGeomType, typename GeomDataType>
@@ -1134,7 +1568,7 @@ namespace
 
         VtVec3fArray& usdVelocities = GetStaticTempArray<VtVec3fArray>();
         usdVelocities.assign(linVels, linVels + geomData.NumPoints);
-        linearVelocitiesAttribute.Set(usdVelocities, timeCode);
+        SetAttributeValue(writer, linearVelocitiesAttribute, usdVelocities, timeCode);
       }
       else
       {
@@ -1167,7 +1601,7 @@ namespace
 
         VtVec3fArray& usdAngularVelocities = GetStaticTempArray<VtVec3fArray>();
         usdAngularVelocities.assign(angVels, angVels + geomData.NumPoints);
-        angularVelocitiesAttribute.Set(usdAngularVelocities, timeCode);
+        SetAttributeValue(writer, angularVelocitiesAttribute, usdAngularVelocities, timeCode);
       }
       else
       {
@@ -1244,17 +1678,37 @@ namespace
 
 UsdPrim UsdBridgeUsdWriter::InitializeUsdGeometry(UsdStageRefPtr geometryStage, const SdfPath& geomPath, const UsdBridgeMeshData& meshData, bool uniformPrim) const
 {
-  return InitializeUsdGeometry_Impl(geometryStage, geomPath, meshData, uniformPrim, Settings);
+  return InitializeUsdGeometry_Impl(geometryStage, geomPath, meshData, uniformPrim, Settings, FullPrecisionAttributes);
 }
 
 UsdPrim UsdBridgeUsdWriter::InitializeUsdGeometry(UsdStageRefPtr geometryStage, const SdfPath& geomPath, const UsdBridgeInstancerData& instancerData, bool uniformPrim) const
 {
-  return InitializeUsdGeometry_Impl(geometryStage, geomPath, instancerData, uniformPrim, Settings);
+  return InitializeUsdGeometry_Impl(geometryStage, geomPath, instancerData, uniformPrim, Settings, FullPrecisionAttributes);
 }
 
 UsdPrim UsdBridgeUsdWriter::InitializeUsdGeometry(UsdStageRefPtr geometryStage, const SdfPath& geomPath, const UsdBridgeCurveData& curveData, bool uniformPrim) const
 {
-  return InitializeUsdGeometry_Impl(geometryStage, geomPath, curveData, uniformPrim, Settings);
+  return InitializeUsdGeometry_Impl(geometryStage, geomPath, curveData, uniformPrim, Settings, FullPrecisionAttributes);
+}
+
+void UsdBridgeUsdWriter::PromoteToFullPrecision(const UsdBridgePrimCache* cacheEntry, const SdfPath& attribPath, const UsdAttribute& outAttrib)
+{
+  // Specs created from now on are declared in full precision
+  FullPrecisionAttributes.insert(attribPath);
+
+  PromoteAttributeSpec(SceneStage->GetRootLayer(), attribPath);
+  if (outAttrib)
+    PromoteAttributeSpec(outAttrib.GetStage()->GetRootLayer(), attribPath);
+
+#ifdef VALUE_CLIP_RETIMING
+  if (cacheEntry)
+  {
+    if (cacheEntry->ManifestStage.second)
+      PromoteAttributeSpec(cacheEntry->ManifestStage.second->GetRootLayer(), attribPath);
+    for (const auto& clipStage : cacheEntry->ClipStages)
+      PromoteAttributeSpec(clipStage.second.second->GetRootLayer(), attribPath);
+  }
+#endif
 }
 
 #ifdef VALUE_CLIP_RETIMING
@@ -1262,7 +1716,7 @@ void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(const UsdBridgePrimCache* cac
 {
   TimeEvaluator<UsdBridgeMeshData> timeEval(meshData);
   InitializeUsdGeometry_Impl(cacheEntry->ManifestStage.second, cacheEntry->PrimPath, meshData, false, 
-    Settings, &timeEval);
+    Settings, FullPrecisionAttributes, &timeEval);
 
   if(this->EnableSaving)
     cacheEntry->ManifestStage.second->Save();
@@ -1272,7 +1726,7 @@ void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(const UsdBridgePrimCache* cac
 {
   TimeEvaluator<UsdBridgeInstancerData> timeEval(instancerData);
   InitializeUsdGeometry_Impl(cacheEntry->ManifestStage.second, cacheEntry->PrimPath, instancerData, false, 
-    Settings, &timeEval);
+    Settings, FullPrecisionAttributes, &timeEval);
 
   if(this->EnableSaving)
     cacheEntry->ManifestStage.second->Save();
@@ -1282,7 +1736,7 @@ void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(const UsdBridgePrimCache* cac
 {
   TimeEvaluator<UsdBridgeCurveData> timeEval(curveData);
   InitializeUsdGeometry_Impl(cacheEntry->ManifestStage.second, cacheEntry->PrimPath, curveData, false, 
-    Settings, &timeEval);
+    Settings, FullPrecisionAttributes, &timeEval);
 
   if(this->EnableSaving)
     cacheEntry->ManifestStage.second->Save();
@@ -1295,7 +1749,14 @@ void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(const UsdBridgePrimCache* cac
 #define UPDATE_USDGEOM_PRIMVAR_ARRAYS(FuncDef) \
   FuncDef(this, timeVarPrimvars, uniformPrimvars, geomData, numPrims, updateEval, timeEval)
 
-void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& meshPath, const UsdBridgeMeshData& geomData, double timeStep)
+// For quantized arrays, which may have to be promoted in all layers of the prim
+#define UPDATE_USDGEOM_QUANTIZED_ARRAYS(FuncDef) \
+  FuncDef(this, timeVarGeom, uniformGeom, geomData, numPrims, updateEval, timeEval, cacheEntry)
+
+#define UPDATE_USDGEOM_QUANTIZED_PRIMVAR_ARRAYS(FuncDef) \
+  FuncDef(this, timeVarPrimvars, uniformPrimvars, geomData, numPrims, updateEval, timeEval, cacheEntry)
+
+void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& meshPath, const UsdBridgeMeshData& geomData, double timeStep, UsdBridgePrimCache* cacheEntry)
 {
   // To avoid data duplication when using of clip stages, we need to potentially use the scenestage prim for time-uniform data.
   UsdGeomMesh uniformGeom = UsdGeomMesh::Get(this->SceneStage, meshPath);
@@ -1314,15 +1775,15 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
   uint64_t numPrims = int(geomData.NumIndices) / geomData.FaceVertexCount;
 
   UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomPoints);
-  UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomNormals);
+  UPDATE_USDGEOM_QUANTIZED_ARRAYS(UpdateUsdGeomNormals);
   if( Settings.EnableStTexCoords && UsdGeomDataHasTexCoords(geomData) ) 
     { UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomTexCoords); }
-  UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
-  UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
-  UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomIndices);
+  UPDATE_USDGEOM_QUANTIZED_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
+  UPDATE_USDGEOM_QUANTIZED_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
+  UpdateUsdGeomIndices(this, timeVarGeom, uniformGeom, geomData, numPrims, updateEval, timeEval, cacheEntry);
 }
 
-void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& instancerPath, const UsdBridgeInstancerData& geomData, double timeStep)
+void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& instancerPath, const UsdBridgeInstancerData& geomData, double timeStep, UsdBridgePrimCache* cacheEntry)
 {
   UsdBridgeUpdateEvaluator<const UsdBridgeInstancerData> updateEval(geomData);
   TimeEvaluator<UsdBridgeInstancerData> timeEval(geomData, timeStep);
@@ -1347,8 +1808,8 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
     UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomOrientNormals);
     if( Settings.EnableStTexCoords && UsdGeomDataHasTexCoords(geomData) ) 
       { UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomTexCoords); }
-    UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
-    UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
+    UPDATE_USDGEOM_QUANTIZED_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
+    UPDATE_USDGEOM_QUANTIZED_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
   }
   else
   {
@@ -1366,8 +1827,8 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
     UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomOrientations);
     if( Settings.EnableStTexCoords && UsdGeomDataHasTexCoords(geomData) ) 
       { UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomTexCoords); }
-    UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
-    UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
+    UPDATE_USDGEOM_QUANTIZED_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
+    UPDATE_USDGEOM_QUANTIZED_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
     UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomShapeIndices);
     UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomLinearVelocities);
     UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomAngularVelocities);
@@ -1375,7 +1836,7 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
   }
 }
 
-void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& curvePath, const UsdBridgeCurveData& geomData, double timeStep)
+void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& curvePath, const UsdBridgeCurveData& geomData, double timeStep, UsdBridgePrimCache* cacheEntry)
 {
   // To avoid data duplication when using of clip stages, we need to potentially use the scenestage prim for time-uniform data.
   UsdGeomBasisCurves uniformGeom = UsdGeomBasisCurves::Get(this->SceneStage, curvePath);
@@ -1393,11 +1854,171 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
   uint64_t numPrims = geomData.NumCurveLengths;
 
   UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomPoints);
-  UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomNormals);
+  UPDATE_USDGEOM_QUANTIZED_ARRAYS(UpdateUsdGeomNormals);
   if( Settings.EnableStTexCoords && UsdGeomDataHasTexCoords(geomData) ) 
     { UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomTexCoords); }
-  UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
-  UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
+  UPDATE_USDGEOM_QUANTIZED_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
+  UPDATE_USDGEOM_QUANTIZED_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
   UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomWidths);
   UPDATE_USDGEOM_ARRAYS(UpdateUsdGeomCurveLengths);
-}
\ No newline at end of file
+}
+
+void UsdBridgeUsdWriter::UpdateUsdGeometryLods(const UsdBridgePrimCache* geomCache, const UsdBridgePrimCache* lodCache, const UsdBridgeMeshData* lodData, uint32_t numLods, double timeStep)
+{
+  const SdfPath& lodPath = lodCache->PrimPath;
+
+  UsdPrim lodPrim = this->SceneStage->GetPrimAtPath(lodPath);
+  assert(lodPrim);
+
+  UsdVariantSets variantSets = lodPrim.GetVariantSets();
+  if (variantSets.HasVariantSet(UsdBridgeTokens->lod) && variantSets.GetVariantSet(UsdBridgeTokens->lod).GetVariantNames().size() > numLods)
+  {
+    // Variants cannot be removed individually, so start from an empty prim
+    this->SceneStage->RemovePrim(lodPath);
+    lodPrim = this->SceneStage->DefinePrim(lodPath);
+  }
+  lodPrim.SetActive(true);
+
+  // Prim type and attributes are defined outside of the variants, each variant only holds values
+  InitializeUsdGeometry(this->SceneStage, lodPath, lodData[0], true);
+  UsdGeomImageable(lodPrim).CreatePurposeAttr().Set(UsdGeomTokens->proxy);
+
+  UsdVariantSet lodVariants = lodPrim.GetVariantSets().AddVariantSet(UsdBridgeTokens->lod);
+  for (uint32_t lodIdx = 0; lodIdx < numLods; ++lodIdx)
+  {
+    std::string variantName = "level" + std::to_string(lodIdx);
+    lodVariants.AddVariant(variantName);
+    lodVariants.SetVariantSelection(variantName);
+
+    UsdEditContext editContext(lodVariants.GetVariantEditContext());
+    UpdateUsdGeometry(this->SceneStage, lodPath, lodData[lodIdx], timeStep);
+  }
+  lodVariants.SetVariantSelection("level0");
+
+  // Renderers showing proxies should not show the full-resolution geometry as well
+  UsdPrim geomPrim = this->SceneStage->GetPrimAtPath(geomCache->PrimPath);
+  assert(geomPrim);
+  UsdGeomImageable(geomPrim).CreatePurposeAttr().Set(UsdGeomTokens->render);
+}
+
+void UsdBridgeUsdWriter::RemoveUsdGeometryLods(const UsdBridgePrimCache* geomCache, const UsdBridgePrimCache* lodCache)
+{
+  // Surfaces may still reference the lod prim until they are recommitted
+  UsdPrim lodPrim = this->SceneStage->GetPrimAtPath(lodCache->PrimPath);
+  if (lodPrim)
+    lodPrim.SetActive(false);
+
+  UsdPrim geomPrim = this->SceneStage->GetPrimAtPath(geomCache->PrimPath);
+  assert(geomPrim);
+  UsdGeomImageable(geomPrim).GetPurposeAttr().Clear();
+}
+
+namespace
+{
+  SdfPath GetGeometryChunkPath(const SdfPath& geomPath, uint32_t chunkIdx)
+  {
+    return geomPath.AppendChild(TfToken(constring::geomChunkPrimPf + std::to_string(chunkIdx)));
+  }
+
+  void RemoveAuthoredAttributes(UsdPrim& prim)
+  {
+    for (const UsdAttribute& attrib : prim.GetAuthoredAttributes())
+      prim.RemoveProperty(attrib.GetName());
+  }
+}
+
+void UsdBridgeUsdWriter::ConvertToChunkedGeometry(const UsdBridgePrimCache* geomCache)
+{
+  // The geometry prim becomes the parent of its chunk prims, without data of its own.
+  // Data of timesteps written before the conversion is left in place, but no longer shows up.
+  UsdPrim geomPrim = this->SceneStage->GetPrimAtPath(geomCache->PrimPath);
+  assert(geomPrim);
+  RemoveAuthoredAttributes(geomPrim);
+  geomPrim.SetTypeName(UsdGeomTokens->Xform);
+
+#ifdef VALUE_CLIP_RETIMING
+  UsdPrim manifestPrim = geomCache->ManifestStage.second->GetPrimAtPath(geomCache->PrimPath);
+  if (manifestPrim)
+    RemoveAuthoredAttributes(manifestPrim);
+#endif
+}
+
+template<typename GeomDataType>
+void UsdBridgeUsdWriter::UpdateUsdGeometryChunksTemplate(UsdStageRefPtr timeVarStage, UsdBridgePrimCache* geomCache, 
+  const GeomDataType* chunkData, uint32_t numChunks, double timeStep)
+{
+  using DMI = typename GeomDataType::DataMemberId;
+
+  // Chunks beyond numChunks (left over from timesteps with more chunks) are hidden. 
+  // Visibility varies over time along with the points.
+  TimeEvaluator<GeomDataType> timeEval(chunkData[0], timeStep);
+  UsdStageRefPtr visStage = timeEval.IsTimeVarying(DMI::POINTS) ? timeVarStage : this->SceneStage;
+  UsdTimeCode visTimeCode = timeEval.Eval(DMI::POINTS);
+
+  for (uint32_t chunkIdx = 0; chunkIdx < geomCache->GeomChunkCount; ++chunkIdx)
+  {
+    SdfPath chunkPath = GetGeometryChunkPath(geomCache->PrimPath, chunkIdx);
+
+    bool chunkInUse = chunkIdx < numChunks;
+    if (chunkInUse)
+    {
+      const GeomDataType& geomData = chunkData[chunkIdx];
+      InitializeUsdGeometry(this->SceneStage, chunkPath, geomData, true);
+      if (timeVarStage != this->SceneStage)
+        InitializeUsdGeometry(timeVarStage, chunkPath, geomData, false);
+
+      UpdateUsdGeometry(timeVarStage, chunkPath, geomData, timeStep, geomCache);
+    }
+
+    UsdPrim visPrim = visStage->OverridePrim(chunkPath);
+    UsdGeomImageable(visPrim).CreateVisibilityAttr().Set(chunkInUse ? UsdGeomTokens->inherited : UsdGeomTokens->invisible, visTimeCode);
+  }
+}
+
+void UsdBridgeUsdWriter::UpdateUsdGeometryChunks(UsdStageRefPtr timeVarStage, UsdBridgePrimCache* geomCache, const UsdBridgeMeshData* chunkData, uint32_t numChunks, double timeStep)
+{
+  UpdateUsdGeometryChunksTemplate(timeVarStage, geomCache, chunkData, numChunks, timeStep);
+}
+
+void UsdBridgeUsdWriter::UpdateUsdGeometryChunks(UsdStageRefPtr timeVarStage, UsdBridgePrimCache* geomCache, const UsdBridgeInstancerData* chunkData, uint32_t numChunks, double timeStep)
+{
+  UpdateUsdGeometryChunksTemplate(timeVarStage, geomCache, chunkData, numChunks, timeStep);
+}
+
+#ifdef VALUE_CLIP_RETIMING
+template<typename GeomDataType>
+void UsdBridgeUsdWriter::UpdateUsdGeometryChunksManifestTemplate(const UsdBridgePrimCache* geomCache, const GeomDataType* chunkData, uint32_t numChunks)
+{
+  using DMI = typename GeomDataType::DataMemberId;
+
+  const UsdStageRefPtr& manifestStage = geomCache->ManifestStage.second;
+  for (uint32_t chunkIdx = 0; chunkIdx < geomCache->GeomChunkCount; ++chunkIdx)
+  {
+    // Chunks that are not in use have the same layout as the others
+    const GeomDataType& geomData = chunkData[std::min(chunkIdx, numChunks-1)];
+    TimeEvaluator<GeomDataType> timeEval(geomData);
+
+    UsdPrim chunkPrim = InitializeUsdGeometry_Impl(manifestStage, GetGeometryChunkPath(geomCache->PrimPath, chunkIdx), geomData, false,
+      Settings, FullPrecisionAttributes, &timeEval);
+
+    // Clips written before a chunk existed have no visibility samples for it, so they fall back to the manifest default
+    if (timeEval.IsTimeVarying(DMI::POINTS))
+      UsdGeomImageable(chunkPrim).CreateVisibilityAttr().Set(UsdGeomTokens->invisible);
+    else
+      chunkPrim.RemoveProperty(UsdGeomTokens->visibility);
+  }
+
+  if(this->EnableSaving)
+    manifestStage->Save();
+}
+
+void UsdBridgeUsdWriter::UpdateUsdGeometryChunksManifest(const UsdBridgePrimCache* geomCache, const UsdBridgeMeshData* chunkData, uint32_t numChunks)
+{
+  UpdateUsdGeometryChunksManifestTemplate(geomCache, chunkData, numChunks);
+}
+
+void UsdBridgeUsdWriter::UpdateUsdGeometryChunksManifest(const UsdBridgePrimCache* geomCache, const UsdBridgeInstancerData* chunkData, uint32_t numChunks)
+{
+  UpdateUsdGeometryChunksManifestTemplate(geomCache, chunkData, numChunks);
+}
+#endif
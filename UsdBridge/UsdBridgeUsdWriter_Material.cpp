@@ -83,7 +83,7 @@ namespace
   }
 
   template<typename ValueType, typename DataType>
-  void SetShaderInput(UsdShadeShader& uniformShadPrim, UsdShadeShader& timeVarShadPrim, const TimeEvaluator<DataType>& timeEval, 
+  void SetShaderInput(UsdBridgeUsdWriter* writer, UsdShadeShader& uniformShadPrim, UsdShadeShader& timeVarShadPrim, const TimeEvaluator<DataType>& timeEval, 
     const TfToken& inputToken, typename DataType::DataMemberId dataMemberId, ValueType value)
   {
     using DMI = typename DataType::DataMemberId;
@@ -108,9 +108,14 @@ namespace
     // Clear the attributes that are not set (based on timeVaryingUpdate)
     ClearUsdAttributes(uniformAttrib, timeVarAttrib, timeVaryingUpdate);
 
-    // Set the input that requires an update
+    // Set the input that requires an update, skipping timesamples that are implied by the previous ones
     if(timeVaryingUpdate)
-      timeVarInput.Set(value, timeEval.Eval(dataMemberId));
+    {
+      const UsdTimeCode& timeCode = timeEval.Eval(dataMemberId);
+      if(!writer->ReduceTimeSample(timeVarAttrib, value, timeCode)
+        && !writer->SkipRedundantTimeSample(timeVarAttrib, HashAttributeValue(value), timeCode))
+        timeVarInput.Set(value, timeCode);
+    }
     else
       uniformInput.Set(value, timeEval.Eval(dataMemberId));
   }
@@ -498,18 +503,48 @@ namespace
       timeVarReaderPrim = InitializeAttributeReader_Impl<PreviewSurface>(timeVarStage, matPrimPath, false, dataMemberId, nullptr);
   }
 
+  #define CREATE_ATTRIBUTE_READERS_MACRO(param, dmi) \
+    if(param.SrcAttrib) \
+    { \
+      UsdShadeShader uniformReaderPrim, timeVarReaderPrim; \
+      GetOrCreateAttributeReaders<PreviewSurface>(sceneStage, timeEval.IsTimeVarying(dmi) ? timeVarStage : sceneStage, \
+        matPrimPath, dmi, uniformReaderPrim, timeVarReaderPrim); \
+    }
+
+  // Creates the attribute readers that UpdateShaderInput() connects to, for the inputs of the PreviewSurface or MDL shader
+  template<bool PreviewSurface>
+  void CreateAttributeReaderSet(UsdStageRefPtr sceneStage, UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath,
+    const UsdBridgeMaterialData& matData, const TimeEvaluator<UsdBridgeMaterialData>& timeEval)
+  {
+    using DMI = UsdBridgeMaterialData::DataMemberId;
+
+    CREATE_ATTRIBUTE_READERS_MACRO(matData.Diffuse, DMI::DIFFUSE);
+    CREATE_ATTRIBUTE_READERS_MACRO(matData.Emissive, DMI::EMISSIVECOLOR);
+    CREATE_ATTRIBUTE_READERS_MACRO(matData.Roughness, DMI::ROUGHNESS);
+    CREATE_ATTRIBUTE_READERS_MACRO(matData.Opacity, DMI::OPACITY);
+    CREATE_ATTRIBUTE_READERS_MACRO(matData.Metallic, DMI::METALLIC);
+    if(PreviewSurface)
+    {
+      CREATE_ATTRIBUTE_READERS_MACRO(matData.Ior, DMI::IOR);
+    }
+    else
+    {
+      CREATE_ATTRIBUTE_READERS_MACRO(matData.EmissiveIntensity, DMI::EMISSIVEINTENSITY);
+    }
+  }
+
   template<bool PreviewSurface, typename DataType>
-  void UpdateAttributeReaderName(UsdShadeShader& uniformReaderPrim, UsdShadeShader& timeVarReaderPrim, 
+  void UpdateAttributeReaderName(UsdBridgeUsdWriter* writer, UsdShadeShader& uniformReaderPrim, UsdShadeShader& timeVarReaderPrim, 
     const TimeEvaluator<DataType>& timeEval, typename DataType::DataMemberId dataMemberId, const TfToken& nameToken)
   {
     // Set the correct attribute token for the reader varname
     if(PreviewSurface)
     {
-      SetShaderInput(uniformReaderPrim, timeVarReaderPrim, timeEval, UsdBridgeTokens->varname, dataMemberId, nameToken);
+      SetShaderInput(writer, uniformReaderPrim, timeVarReaderPrim, timeEval, UsdBridgeTokens->varname, dataMemberId, nameToken);
     }
     else
     {
-      SetShaderInput(uniformReaderPrim, timeVarReaderPrim, timeEval, UsdBridgeTokens->name, dataMemberId, nameToken.GetString());
+      SetShaderInput(writer, uniformReaderPrim, timeVarReaderPrim, timeEval, UsdBridgeTokens->name, dataMemberId, nameToken.GetString());
     }
   }
 
@@ -533,7 +568,7 @@ namespace
       assert(uniformReaderPrim);
       assert(!isTimeVarying || timeVarReaderPrim);
 
-      UpdateAttributeReaderName<PreviewSurface>(uniformReaderPrim, timeVarReaderPrim, timeEval, dataMemberId, writer->AttributeNameToken(param.SrcAttrib));
+      UpdateAttributeReaderName<PreviewSurface>(writer, uniformReaderPrim, timeVarReaderPrim, timeEval, dataMemberId, writer->AttributeNameToken(param.SrcAttrib));
 
       // Connect the reader to the material shader input
       timeVarShadPrim.GetInput(inputToken).GetAttr().Clear(); // Clear timevar data written earlier, will be replaced by connection
@@ -548,7 +583,7 @@ namespace
         uniformDiffInput.DisconnectSource();
 
       // Just treat like regular time-varying inputs
-      SetShaderInput(uniformShadPrim, timeVarShadPrim, timeEval, inputToken, dataMemberId, inputValue);
+      SetShaderInput(writer, uniformShadPrim, timeVarShadPrim, timeEval, inputToken, dataMemberId, inputValue);
     }
   }
 
@@ -611,7 +646,7 @@ namespace
   }
 
   template<bool PreviewSurface>
-  void UpdateSamplerInputs(UsdStageRefPtr sceneStage, UsdStageRefPtr timeVarStage, const SdfPath& samplerPrimPath, const UsdBridgeSamplerData& samplerData, 
+  void UpdateSamplerInputs(UsdBridgeUsdWriter* writer, UsdStageRefPtr sceneStage, UsdStageRefPtr timeVarStage, const SdfPath& samplerPrimPath, const UsdBridgeSamplerData& samplerData, 
     const char* imgFileName, const TfToken& attributeNameToken, const TimeEvaluator<UsdBridgeSamplerData>& timeEval)
   {
     typedef UsdBridgeSamplerData::DataMemberId DMI;
@@ -636,12 +671,12 @@ namespace
     if(PreviewSurface)
     {
       // Set all the inputs
-      SetShaderInput(uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->file, DMI::DATA, texFile);
-      SetShaderInput(uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->WrapS, DMI::WRAPS, TextureWrapToken(samplerData.WrapS));
+      SetShaderInput(writer, uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->file, DMI::DATA, texFile);
+      SetShaderInput(writer, uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->WrapS, DMI::WRAPS, TextureWrapToken(samplerData.WrapS));
       if((uint32_t)samplerData.Type >= (uint32_t)UsdBridgeSamplerData::SamplerType::SAMPLER_2D)
-        SetShaderInput(uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->WrapT, DMI::WRAPT, TextureWrapToken(samplerData.WrapT));
+        SetShaderInput(writer, uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->WrapT, DMI::WRAPT, TextureWrapToken(samplerData.WrapT));
       if((uint32_t)samplerData.Type >= (uint32_t)UsdBridgeSamplerData::SamplerType::SAMPLER_3D)
-        SetShaderInput(uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->WrapR, DMI::WRAPR, TextureWrapToken(samplerData.WrapR));
+        SetShaderInput(writer, uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->WrapR, DMI::WRAPR, TextureWrapToken(samplerData.WrapR));
 
       // Check whether the output type is still correct
       // (Experimental: assume the output type doesn't change over time, this just gives it a chance to match the image type)
@@ -660,15 +695,15 @@ namespace
     else
     {
       // Set all the inputs
-      SetShaderInput(uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->tex, DMI::DATA, texFile);
-      SetShaderInput(uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->wrap_u, DMI::WRAPS, TextureWrapInt(samplerData.WrapS));
+      SetShaderInput(writer, uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->tex, DMI::DATA, texFile);
+      SetShaderInput(writer, uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->wrap_u, DMI::WRAPS, TextureWrapInt(samplerData.WrapS));
       if((uint32_t)samplerData.Type >= (uint32_t)UsdBridgeSamplerData::SamplerType::SAMPLER_2D)
-        SetShaderInput(uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->wrap_v, DMI::WRAPT, TextureWrapInt(samplerData.WrapT));
+        SetShaderInput(writer, uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->wrap_v, DMI::WRAPT, TextureWrapInt(samplerData.WrapT));
       if((uint32_t)samplerData.Type >= (uint32_t)UsdBridgeSamplerData::SamplerType::SAMPLER_3D)
-        SetShaderInput(uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->wrap_w, DMI::WRAPR, TextureWrapInt(samplerData.WrapR)); 
+        SetShaderInput(writer, uniformSamplerPrim, timeVarSamplerPrim, timeEval, UsdBridgeTokens->wrap_w, DMI::WRAPR, TextureWrapInt(samplerData.WrapR)); 
     }
 
-    UpdateAttributeReaderName<PreviewSurface>(uniformTcReaderPrim, timeVarTcReaderPrim, timeEval, DMI::INATTRIBUTE, attributeNameToken);
+    UpdateAttributeReaderName<PreviewSurface>(writer, uniformTcReaderPrim, timeVarTcReaderPrim, timeEval, DMI::INATTRIBUTE, attributeNameToken);
   }
 }
 
@@ -731,6 +766,18 @@ void UsdBridgeUsdWriter::ConnectSamplerToMaterial(UsdStageRefPtr materialStage,
   }
 }
 
+void UsdBridgeUsdWriter::CreateUsdMaterialAttributeReaders(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, const UsdBridgeMaterialData& matData, double timeStep)
+{
+  // Readers are created on demand by UpdateUsdMaterial() as well, but a prim defined within a change block can't be retrieved until the block closes
+  TimeEvaluator<UsdBridgeMaterialData> timeEval(matData, timeStep);
+
+  if(Settings.EnablePreviewSurfaceShader)
+    CreateAttributeReaderSet<true>(SceneStage, timeVarStage, matPrimPath, matData, timeEval);
+
+  if(Settings.EnableMdlShader)
+    CreateAttributeReaderSet<false>(SceneStage, timeVarStage, matPrimPath, matData, timeEval);
+}
+
 void UsdBridgeUsdWriter::UpdateUsdMaterial(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, const UsdBridgeMaterialData& matData, double timeStep)
 {
   // Update usd shader
@@ -804,7 +851,7 @@ void UsdBridgeUsdWriter::UpdateMdlShader(UsdStageRefPtr timeVarStage, const SdfP
   UPDATE_MDL_SHADER_INPUT_MACRO(DMI::ROUGHNESS, matData.Roughness);
   UPDATE_MDL_SHADER_INPUT_MACRO(DMI::METALLIC, matData.Metallic);
   //UPDATE_MDL_SHADER_INPUT_MACRO(DMI::IOR, matData.Ior);
-  SetShaderInput(uniformShadPrim, timeVarShadPrim, timeEval, UsdBridgeTokens->enable_emission, DMI::EMISSIVEINTENSITY, enableEmission); // Just a value, not connected to attribreaders
+  SetShaderInput(this, uniformShadPrim, timeVarShadPrim, timeEval, UsdBridgeTokens->enable_emission, DMI::EMISSIVEINTENSITY, enableEmission); // Just a value, not connected to attribreaders
 
 #ifdef CUSTOM_PBR_MDL
   if (!matData.HasTranslucency)
@@ -836,13 +883,13 @@ void UsdBridgeUsdWriter::UpdateUsdSampler(UsdStageRefPtr timeVarStage, const Sdf
   if(Settings.EnablePreviewSurfaceShader)
   {
     SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(SdfPath(constring::psSamplerPrimPf));
-    UpdateSamplerInputs<true>(SceneStage, timeVarStage, usdSamplerPrimPath, samplerData, imgFileName, attribNameToken, timeEval);
+    UpdateSamplerInputs<true>(this, SceneStage, timeVarStage, usdSamplerPrimPath, samplerData, imgFileName, attribNameToken, timeEval);
   }
 
   if(Settings.EnableMdlShader)
   {
     SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(SdfPath(constring::mdlSamplerPrimPf));
-    UpdateSamplerInputs<false>(SceneStage, timeVarStage, usdSamplerPrimPath, samplerData, imgFileName, attribNameToken, timeEval);
+    UpdateSamplerInputs<false>(this, SceneStage, timeVarStage, usdSamplerPrimPath, samplerData, imgFileName, attribNameToken, timeEval);
   }
 
   // Update resources
@@ -906,11 +953,11 @@ namespace
       assert(timeVarAttribReader);
     }
 
-    UpdateAttributeReaderName<PreviewSurface>(uniformAttribReader, timeVarAttribReader, timeEval, dataMemberId, newNameToken);
+    UpdateAttributeReaderName<PreviewSurface>(writer, uniformAttribReader, timeVarAttribReader, timeEval, dataMemberId, newNameToken);
   }
 
   template<bool PreviewSurface>
-  void UpdateSamplerTcReader(UsdStageRefPtr sceneStage, UsdStageRefPtr timeVarStage, const SdfPath& samplerPrimPath, const TfToken& newNameToken, const TimeEvaluator<UsdBridgeSamplerData>& timeEval)
+  void UpdateSamplerTcReader(UsdBridgeUsdWriter* writer, UsdStageRefPtr sceneStage, UsdStageRefPtr timeVarStage, const SdfPath& samplerPrimPath, const TfToken& newNameToken, const TimeEvaluator<UsdBridgeSamplerData>& timeEval)
   {
     typedef UsdBridgeSamplerData::DataMemberId DMI;
 
@@ -924,7 +971,7 @@ namespace
     assert(timeVarTcReaderPrim);
 
     // Set the new Inattribute
-    UpdateAttributeReaderName<PreviewSurface>(uniformTcReaderPrim, timeVarTcReaderPrim, timeEval, DMI::INATTRIBUTE, newNameToken);
+    UpdateAttributeReaderName<PreviewSurface>(writer, uniformTcReaderPrim, timeVarTcReaderPrim, timeEval, DMI::INATTRIBUTE, newNameToken);
   }
 }
 
@@ -962,13 +1009,13 @@ void UsdBridgeUsdWriter::UpdateInAttribute(UsdStageRefPtr timeVarStage, const Sd
   if(Settings.EnablePreviewSurfaceShader)
   {
     SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(SdfPath(constring::psSamplerPrimPf));
-    UpdateSamplerTcReader<true>(SceneStage, timeVarStage, usdSamplerPrimPath, newNameToken, timeEval);
+    UpdateSamplerTcReader<true>(this, SceneStage, timeVarStage, usdSamplerPrimPath, newNameToken, timeEval);
   }
 
   if(Settings.EnableMdlShader)
   {
     SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(SdfPath(constring::mdlSamplerPrimPf));
-    UpdateSamplerTcReader<false>(SceneStage, timeVarStage, usdSamplerPrimPath, newNameToken, timeEval);
+    UpdateSamplerTcReader<false>(this, SceneStage, timeVarStage, usdSamplerPrimPath, newNameToken, timeEval);
   }
 }
 
@@ -27,6 +27,8 @@
 #include <pxr/usd/usd/modelAPI.h>
 #include <pxr/usd/usd/clipsAPI.h>
 #include <pxr/usd/usd/inherits.h>
+#include <pxr/usd/usd/variantSets.h>
+#include <pxr/usd/usd/editContext.h>
 #include <pxr/usd/usdGeom/mesh.h>
 #include <pxr/usd/usdGeom/points.h>
 #include <pxr/usd/usdGeom/sphere.h>
@@ -40,6 +42,10 @@
 #include <pxr/usd/usdVol/volume.h>
 #include <pxr/usd/usdVol/openVDBAsset.h>
 #include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/fileFormat.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/schema.h>
+#include <pxr/usd/sdf/attributeSpec.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usdShade/material.h>
 #include <pxr/usd/usdShade/materialBindingAPI.h>
@@ -6,6 +6,8 @@
 #include "UsdAnari.h"
 #include "anari/type_utility.h"
 
+#include <atomic>
+
 DEFINE_PARAMETER_MAP(UsdDataArray,
   REGISTER_PARAMETER_MACRO("name", ANARI_STRING, name)
   REGISTER_PARAMETER_MACRO("usd::name", ANARI_STRING, usdName)
@@ -13,6 +15,11 @@ DEFINE_PARAMETER_MAP(UsdDataArray,
 
 #define TO_OBJ_PTR reinterpret_cast<const ANARIObject*>
 
+namespace
+{
+  std::atomic<uint64_t> arrayVersionCounter(0);
+}
+
 UsdDataArray::UsdDataArray(const void *appMemory,
   ANARIMemoryDeleter deleter,
   const void *userData,
@@ -36,6 +43,7 @@ UsdDataArray::UsdDataArray(const void *appMemory,
 #endif
 {
   setLayoutAndSize(numItems1, byteStride1, numItems2, byteStride2, numItems3, byteStride3);
+  bumpVersion();
 
   if (CheckFormatting(device))
   {
@@ -53,6 +61,7 @@ UsdDataArray::UsdDataArray(ANARIDataType dataType, uint64_t numItems1, uint64_t
   , isPrivate(true)
 {
   setLayoutAndSize(numItems1, 0, numItems2, 0, numItems3, 0);
+  bumpVersion();
 
   if (CheckFormatting(device))
   {
@@ -122,6 +131,8 @@ void UsdDataArray::commit(UsdDevice* device)
 {
   transferWriteToReadParams();
 
+  bumpVersion(); // Shared application memory may have changed
+
   if (anari::isObject(type) && (layout.numItems2 != 1 || layout.numItems3 != 1))
     device->reportStatus(this, ANARI_ARRAY, ANARI_SEVERITY_ERROR, ANARI_STATUS_INVALID_ARGUMENT,
       "UsdDataArray only supports one-dimensional ANARI_OBJECT arrays");
@@ -143,6 +154,13 @@ void UsdDataArray::unmap(UsdDevice * device)
   {
     TransferAndRemoveMappedObjectCopy();
   }
+
+  bumpVersion();
+}
+
+void UsdDataArray::bumpVersion()
+{
+  version = ++arrayVersionCounter;
 }
 
 void UsdDataArray::privatize()
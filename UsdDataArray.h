@@ -84,6 +84,9 @@ class UsdDataArray : public UsdBaseObject, public UsdParameterizedObject<UsdData
 
     size_t getDataSizeInBytes() const { return dataSizeInBytes; }
 
+    // Changes whenever the array contents may have been modified, unique across all arrays
+    uint64_t getVersion() const { return version; }
+
   protected:
     bool deferCommit(UsdDevice* device) override { return false; }
     bool doCommitData(UsdDevice* device) override { return false; }
@@ -96,6 +99,7 @@ class UsdDataArray : public UsdBaseObject, public UsdParameterizedObject<UsdData
       uint64_t numItems3,
       int64_t byteStride3);
     bool CheckFormatting(UsdDevice* device);
+    void bumpVersion();
 
     // Ref manipulation on arrays of anariobjects
     void incRef(const ANARIObject* anariObjects, uint64_t numAnariObjects);
@@ -118,6 +122,7 @@ class UsdDataArray : public UsdBaseObject, public UsdParameterizedObject<UsdData
     UsdDataLayout layout;
     size_t dataSizeInBytes;
     bool isPrivate;
+    uint64_t version = 0;
 
     const void* mappedObjectCopy;
 
@@ -20,6 +20,7 @@
 #include <cstdarg>
 #include <cstdio>
 #include <set>
+#include <unordered_set>
 #include <memory>
 #include <sstream>
 #include <algorithm>
@@ -55,6 +56,7 @@ class UsdDeviceInternals
 {
 public:
   UsdDeviceInternals()
+    : geometryScratchArena(std::make_unique<UsdGeometryScratchArena>())
   {
   }
 
@@ -69,7 +71,14 @@ public:
       deviceParams.createNewSession,
       deviceParams.outputBinary,
       deviceParams.outputPreviewSurfaceShader,
-      deviceParams.outputMdlShader
+      deviceParams.outputMdlShader,
+      deviceParams.outputQuantize,
+      deviceParams.outputQuantizeErrorBound,
+      deviceParams.dedupGeometry,
+      deviceParams.outputIndexPrimvars,
+      deviceParams.outputIndexPrimvarsMaxValues,
+      deviceParams.directLayerAuthoring,
+      deviceParams.timeCompressionTolerance
     };
 
     bridge = std::make_unique<UsdBridge>(bridgeSettings);
@@ -99,8 +108,11 @@ public:
   bool enableSaving = true;
   std::unique_ptr<UsdBridge> bridge;
   SceneStagePtr externalSceneStage{nullptr};
+  bool garbageCollectPending = false; // Collection exceeded its time budget, continued at the next renderFrame
 
   std::set<std::string> uniqueNames;
+
+  std::unique_ptr<UsdGeometryScratchArena> geometryScratchArena;
 };
 
 
@@ -114,6 +126,16 @@ DEFINE_PARAMETER_MAP(UsdDevice,
   REGISTER_PARAMETER_MACRO("usd::output.material", ANARI_BOOL, outputMaterial)
   REGISTER_PARAMETER_MACRO("usd::output.previewSurfaceShader", ANARI_BOOL, outputPreviewSurfaceShader)
   REGISTER_PARAMETER_MACRO("usd::output.mdlShader", ANARI_BOOL, outputMdlShader)
+  REGISTER_PARAMETER_MACRO("usd::output.quantize", ANARI_BOOL, outputQuantize)
+  REGISTER_PARAMETER_MACRO("usd::output.quantize.errorBound", ANARI_FLOAT32, outputQuantizeErrorBound)
+  REGISTER_PARAMETER_MACRO("usd::output.indexPrimvars", ANARI_BOOL, outputIndexPrimvars)
+  REGISTER_PARAMETER_MACRO("usd::output.indexPrimvars.maxValues", ANARI_UINT32, outputIndexPrimvarsMaxValues)
+  REGISTER_PARAMETER_MACRO("usd::dedupGeometry", ANARI_BOOL, dedupGeometry)
+  REGISTER_PARAMETER_MACRO("usd::directLayerAuthoring", ANARI_BOOL, directLayerAuthoring)
+  REGISTER_PARAMETER_MACRO("usd::timeCompression.tolerance", ANARI_FLOAT32, timeCompressionTolerance)
+  REGISTER_PARAMETER_MACRO("usd::scratch.memoryLimit", ANARI_UINT64, scratchMemoryLimit)
+  REGISTER_PARAMETER_MACRO("usd::chunkSize", ANARI_UINT64, chunkSize)
+  REGISTER_PARAMETER_MACRO("usd::garbageCollect.timeBudget", ANARI_FLOAT64, garbageCollectTimeBudget)
 )
 
 UsdDevice::UsdDevice()
@@ -203,7 +225,7 @@ void UsdDevice::deviceSetParameter(
   {
     // Perform garbage collection on usd objects (needs to move into the user interface)
     if(internals->bridge)
-      internals->bridge->GarbageCollect();
+      internals->garbageCollectPending = !internals->bridge->GarbageCollect(getReadParams().garbageCollectTimeBudget);
   }
   else if(strEquals(id, "usd::removeUnusedNames"))
   {
@@ -485,7 +507,7 @@ ANARIInstance UsdDevice::newInstance()
 ANARIWorld UsdDevice::newWorld()
 {
   const char* name = makeUniqueName("World");
-  UsdWorld* object = new UsdWorld(name, internals->bridge.get());
+  UsdWorld* object = new UsdWorld(name, internals->bridge.get(), this);
 #ifdef CHECK_MEMLEAKS
   LogAllocation(object);
 #endif
@@ -513,6 +535,9 @@ void UsdDevice::renderFrame(ANARIFrame frame)
 
   internals->bridge->ResetResourceUpdateState(); // Reset the modified flags for committed shared resources
 
+  if(internals->garbageCollectPending)
+    internals->garbageCollectPending = !internals->bridge->GarbageCollect(getReadParams().garbageCollectTimeBudget);
+
   UsdRenderer* ren = ((UsdFrame*)frame)->getRenderer();
   if(ren)
     ren->saveUsd();
@@ -537,6 +562,11 @@ const char* UsdDevice::makeUniqueName(const char* name)
   return empRes.first->c_str();
 }
 
+UsdGeometryScratchArena* UsdDevice::getGeometryScratchArena()
+{
+  return internals->geometryScratchArena.get();
+}
+
 bool UsdDevice::nameExists(const char* name)
 {
   return internals->uniqueNames.find(name) != internals->uniqueNames.end();
@@ -599,6 +629,36 @@ void UsdDevice::flushCommitList()
     }
   }
 
+  // Automatically commit worlds which write their instances as point instancers,
+  // but for which any of those instances is in commitlist.
+  std::unordered_set<const UsdBaseObject*> committedInstances;
+  for(const CommitListType& entry : commitList)
+  {
+    if(entry.first->getType() == ANARI_INSTANCE)
+      committedInstances.insert(entry.first.ptr);
+  }
+  if(!committedInstances.empty())
+  {
+    for(UsdWorld* world : worldList)
+    {
+      const UsdWorldData& readParams = world->getReadParams();
+      if(!readParams.instancing || !readParams.instances || readParams.instances->getType() != ANARI_INSTANCE)
+        continue;
+
+      const ANARIInstance* instances = reinterpret_cast<const ANARIInstance*>(readParams.instances->getData());
+      uint64_t numInstances = readParams.instances->getLayout().numItems1;
+      for(uint64_t i = 0; i < numInstances; ++i)
+      {
+        if(committedInstances.count(static_cast<const UsdBaseObject*>(reinterpret_cast<const UsdInstance*>(instances[i]))))
+        {
+          world->setInstancersDirty();
+          addToCommitList(world, true);
+          break;
+        }
+      }
+    }
+  }
+
   lockCommitList = true;
 
   writeTypeToUsd<(int)ANARI_SAMPLER>();
@@ -619,6 +679,8 @@ void UsdDevice::flushCommitList()
   clearCommitList();
 
   lockCommitList = false;
+
+  internals->geometryScratchArena->trim(getReadParams().scratchMemoryLimit);
 }
 
 void UsdDevice::addToVolumeList(UsdVolume* volume)
@@ -628,6 +690,23 @@ void UsdDevice::addToVolumeList(UsdVolume* volume)
     volumeList.emplace_back(volume);
 }
 
+void UsdDevice::addToWorldList(UsdWorld* world)
+{
+  auto it = std::find(worldList.begin(), worldList.end(), world);
+  if(it == worldList.end())
+    worldList.emplace_back(world);
+}
+
+void UsdDevice::removeFromWorldList(UsdWorld* world)
+{
+  auto it = std::find(worldList.begin(), worldList.end(), world);
+  if(it != worldList.end())
+  {
+    *it = worldList.back();
+    worldList.pop_back();
+  }
+}
+
 void UsdDevice::addToSharedStringList(UsdSharedString* string)
 {
   sharedStringList.push_back(anari::IntrusivePtr<UsdSharedString>(string));
@@ -31,6 +31,8 @@ class UsdDevice;
 class UsdDeviceInternals;
 class UsdBaseObject;
 class UsdVolume;
+class UsdWorld;
+class UsdGeometryScratchArena;
 
 struct UsdDeviceData
 {
@@ -45,6 +47,23 @@ struct UsdDeviceData
   bool outputMaterial = true;
   bool outputPreviewSurfaceShader = true;
   bool outputMdlShader = true;
+  bool outputQuantize = false;
+  float outputQuantizeErrorBound = 1e-3f; // Max error of quantized values, relative to their magnitude if above 1
+
+  bool outputIndexPrimvars = false;
+  uint32_t outputIndexPrimvarsMaxValues = 256; // Max amount of distinct values of an indexed primvar
+
+  bool dedupGeometry = false;
+
+  bool directLayerAuthoring = false;
+
+  float timeCompressionTolerance = 0.0f; // Max absolute error of interpolated timesamples, 0 disables keyframe reduction
+
+  uint64_t scratchMemoryLimit = 256ull << 20; // Bytes of geometry conversion scratch memory kept in between frames
+
+  uint64_t chunkSize = 0; // Max amount of faces or points per chunk of a geometry, 0 disables chunking
+
+  double garbageCollectTimeBudget = 0.0; // Milliseconds spent on garbage collection per call or frame, 0 is unlimited
 };
 
 class UsdDevice : public anari::DeviceImpl, anari::RefCounted, public UsdParameterizedObject<UsdDevice, UsdDeviceData>
@@ -173,9 +192,14 @@ class UsdDevice : public anari::DeviceImpl, anari::RefCounted, public UsdParamet
     void flushCommitList();
     bool isFlushingCommitList() const { return lockCommitList; }
 
+    UsdGeometryScratchArena* getGeometryScratchArena();
+
     void addToVolumeList(UsdVolume* volume);
     void removeFromVolumeList(UsdVolume* volume);
 
+    void addToWorldList(UsdWorld* world);
+    void removeFromWorldList(UsdWorld* world);
+
     // Allows for selected strings to persist, 
     // so their pointers can be cached beyond their containing objects' lifetimes
     void addToSharedStringList(UsdSharedString* sharedString); 
@@ -233,6 +257,7 @@ class UsdDevice : public anari::DeviceImpl, anari::RefCounted, public UsdParamet
     using CommitListType = std::pair<anari::IntrusivePtr<UsdBaseObject>,bool>;
     std::vector<CommitListType> commitList;
     std::vector<UsdVolume*> volumeList; // Tracks all volumes to auto-commit when child fields have been committed
+    std::vector<UsdWorld*> worldList; // Tracks all worlds to auto-commit when instances written as point instancers have been committed
     bool lockCommitList = false;
 
     std::vector<anari::IntrusivePtr<UsdSharedString>> sharedStringList;
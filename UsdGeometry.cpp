@@ -6,8 +6,16 @@
 #include "UsdDataArray.h"
 #include "UsdDevice.h"
 #include "UsdBridgeUtils.h"
+#include "UsdBridgeParallel.h"
+#include "UsdGeometryLod.h"
+#include "UsdGeometryReorder.h"
+#include "UsdGeometryChunks.h"
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <thread>
 
 DEFINE_PARAMETER_MAP(UsdGeometry,
   REGISTER_PARAMETER_MACRO("name", ANARI_STRING, name)
@@ -27,17 +35,58 @@ DEFINE_PARAMETER_MAP(UsdGeometry,
   REGISTER_PARAMETER_MACRO("vertex.radius", ANARI_ARRAY, vertexRadii)
   REGISTER_PARAMETER_ARRAY_MACRO("vertex.attribute", ANARI_ARRAY, vertexAttributes, MAX_ATTRIBS)
   REGISTER_PARAMETER_MACRO("radius", ANARI_FLOAT32, radiusConstant)
+  REGISTER_PARAMETER_MACRO("usd::lod.levels", ANARI_ARRAY, lodLevels)
+  REGISTER_PARAMETER_MACRO("usd::reorder", ANARI_BOOL, reorder)
 ) // See .h for usage.
 
 static constexpr int TIMEVAR_ATTRIBUTE_START_BIT = 6;
 
+// Versions of the source arrays from which the indexed sphere temp arrays were last gathered
+struct UsdGeometryGatherVersions
+{
+  static constexpr uint64_t InvalidVersion = ~uint64_t(0);
+
+  // Any change in topology invalidates all gathered streams
+  void checkTopology(const UsdDataArray* indices, uint64_t numVertices)
+  {
+    uint64_t indicesVersion = indices->getVersion();
+    if(indicesVersion != Indices || numVertices != NumVertices)
+    {
+      Indices = indicesVersion;
+      NumVertices = numVertices;
+      Normals = Scales = Colors = Ids = InvalidVersion;
+      std::fill(Attributes.begin(), Attributes.end(), InvalidVersion);
+    }
+  }
+
+  // Returns whether a stream has to be gathered from srcArray (nullptr if the stream should be empty), and records its version
+  bool gatherRequired(uint64_t& gatheredVersion, const UsdDataArray* srcArray)
+  {
+    uint64_t srcVersion = srcArray ? srcArray->getVersion() : 0;
+    bool required = (gatheredVersion != srcVersion);
+    gatheredVersion = srcVersion;
+    return required;
+  }
+
+  uint64_t Indices = InvalidVersion;
+  uint64_t NumVertices = 0;
+  uint64_t Normals = InvalidVersion;
+  uint64_t Scales = InvalidVersion;
+  uint64_t Colors = InvalidVersion;
+  uint64_t Ids = InvalidVersion;
+  std::vector<uint64_t> Attributes;
+};
+
+constexpr uint64_t UsdGeometryGatherVersions::InvalidVersion;
+
 struct UsdGeometryTempArrays
 {
-  UsdGeometryTempArrays(const UsdGeometry::AttributeArray& attributes)
+  UsdGeometryTempArrays(const UsdGeometry::AttributeArray* attributes)
     : Attributes(attributes)
   {}
 
   std::vector<int> CurveLengths;
+  std::vector<uint64_t> StrandStarts;
   std::vector<float> PointsArray;
   std::vector<float> NormalsArray;
   std::vector<float> ScalesArray;
@@ -47,28 +96,38 @@ struct UsdGeometryTempArrays
   std::vector<char> ColorsArray; // generic byte array
   ANARIDataType ColorsArrayType;
   UsdGeometry::AttributeDataArraysType AttributeDataArrays;
+  UsdGeometryGatherVersions GatherVersions;
   
-  const UsdGeometry::AttributeArray& Attributes;
-  
-  void resetColorsArray(size_t numElements, ANARIDataType type)
-  {
-    ColorsArray.resize(numElements*anari::sizeOf(type));
-    ColorsArrayType = type;
-  }
+  const UsdGeometry::AttributeArray* Attributes;
 
-  void reserveColorsArray(size_t numElements)
+  template<typename FuncType>
+  void forEachBuffer(FuncType&& func)
   {
-    ColorsArray.reserve(numElements*anari::sizeOf(ColorsArrayType));
+    func(CurveLengths);
+    func(StrandStarts);
+    func(PointsArray);
+    func(NormalsArray);
+    func(ScalesArray);
+    func(OrientationsArray);
+    func(IdsArray);
+    func(InvisIdsArray);
+    func(ColorsArray);
+    for(auto& attribDataArray : AttributeDataArrays)
+      func(attribDataArray);
   }
 
-  size_t expandColorsArray(size_t numElements)
+  void resizeAttributeDataArrays(size_t numAttributes)
   {
-    size_t startByte = ColorsArray.size();
-    size_t typeSize = anari::sizeOf(ColorsArrayType);
-    ColorsArray.resize(startByte+numElements*typeSize);
-    return startByte/typeSize;
+    AttributeDataArrays.resize(numAttributes);
+    GatherVersions.Attributes.resize(numAttributes, UsdGeometryGatherVersions::InvalidVersion);
   }
   
+  void resetColorsArray(size_t numElements, ANARIDataType type)
+  {
+    ColorsArray.resize(numElements*anari::sizeOf(type));
+    ColorsArrayType = type;
+  }
+
   void copyToColorsArray(const void* source, size_t srcIdx, size_t destIdx, size_t numElements)
   {
     size_t typeSize = anari::sizeOf(ColorsArrayType);
@@ -81,42 +140,23 @@ struct UsdGeometryTempArrays
 
   void resetAttributeDataArray(size_t attribIdx, size_t numElements)
   {
-    if(Attributes[attribIdx].Data)
+    const UsdBridgeAttribute& attrib = (*Attributes)[attribIdx];
+    if(attrib.Data)
     {
-      uint32_t eltSize = Attributes[attribIdx].EltSize;
+      uint32_t eltSize = attrib.EltSize;
       AttributeDataArrays[attribIdx].resize(numElements*eltSize);
     }
     else
       AttributeDataArrays[attribIdx].resize(0);
   }
   
-  void reserveAttributeDataArray(size_t attribIdx, size_t numElements)
-  {
-    if(Attributes[attribIdx].Data)
-    {
-      uint32_t eltSize = Attributes[attribIdx].EltSize;
-      AttributeDataArrays[attribIdx].reserve(numElements*eltSize);
-    } 
-  }
-
-  size_t expandAttributeDataArray(size_t attribIdx, size_t numElements)
-  {
-    if(Attributes[attribIdx].Data)
-    {
-      uint32_t eltSize = Attributes[attribIdx].EltSize;
-      size_t startByte = AttributeDataArrays[attribIdx].size();
-      AttributeDataArrays[attribIdx].resize(startByte+numElements*eltSize);
-      return startByte/eltSize;
-    }
-    return 0;
-  }
-
   void copyToAttributeDataArray(size_t attribIdx, size_t srcIdx, size_t destIdx, size_t numElements)
   {
-    if(Attributes[attribIdx].Data)
+    const UsdBridgeAttribute& attrib = (*Attributes)[attribIdx];
+    if(attrib.Data)
     {
-      uint32_t eltSize = Attributes[attribIdx].EltSize;
-      const void* attribSrc = reinterpret_cast<const char*>(Attributes[attribIdx].Data) + srcIdx*eltSize;
+      uint32_t eltSize = attrib.EltSize;
+      const void* attribSrc = reinterpret_cast<const char*>(attrib.Data) + srcIdx*eltSize;
       size_t dstStart = destIdx*eltSize;
       size_t numBytes = numElements*eltSize;
       assert(dstStart+numBytes <= AttributeDataArrays[attribIdx].size());
@@ -133,6 +173,17 @@ namespace
     return (bool)(value & (1 << bit));
   }
 
+  uint64_t getNumChunkablePrims(const UsdBridgeMeshData& meshData)
+  {
+    uint64_t numIndices = meshData.Indices ? meshData.NumIndices : meshData.NumPoints;
+    return numIndices / meshData.FaceVertexCount;
+  }
+
+  uint64_t getNumChunkablePrims(const UsdBridgeInstancerData& instancerData)
+  {
+    return instancerData.NumPoints;
+  }
+
   size_t getIndex(const void* indices, ANARIDataType type, size_t elt)
   {
     size_t result;
@@ -238,87 +289,143 @@ namespace
 
       uint64_t numVertices = paramData.vertexPositions->getLayout().numItems1;
 
-      bool perPrimNormals = !paramData.vertexNormals && paramData.primitiveNormals;
-      bool perPrimScales = !paramData.vertexRadii && paramData.primitiveRadii;
-      bool perPrimColors = !paramData.vertexColors && paramData.primitiveColors;
-
-      ANARIDataType colorType = perPrimColors ? paramData.primitiveColors->getType() : ANARI_UINT8; // Vertex colors aren't reordered
-
       // Effectively only has to reorder if the source array is perPrim, otherwise this function effectively falls through and the source array is assigned directly at parent scope.
-      tempArrays->NormalsArray.resize(perPrimNormals ? numVertices*3 : 0);
-      tempArrays->ScalesArray.resize(perPrimScales ?  numVertices : 0);
-      tempArrays->IdsArray.resize(numVertices, -1); // Always filled, since indices implies necessity for invisibleIds, and therefore also an Id array
-      tempArrays->resetColorsArray(perPrimColors ?  numVertices : 0, colorType);
+      const UsdDataArray* normalsSrc = !paramData.vertexNormals ? paramData.primitiveNormals : nullptr;
+      const UsdDataArray* scalesSrc = !paramData.vertexRadii ? paramData.primitiveRadii : nullptr;
+      const UsdDataArray* colorsSrc = !paramData.vertexColors ? paramData.primitiveColors : nullptr;
+
+      // Only regather the streams of which the source array (or the topology) changed since the last commit
+      UsdGeometryGatherVersions& gatherVersions = tempArrays->GatherVersions;
+      gatherVersions.checkTopology(paramData.indices, numVertices);
+
+      bool gatherNormals = gatherVersions.gatherRequired(gatherVersions.Normals, normalsSrc);
+      bool gatherScales = gatherVersions.gatherRequired(gatherVersions.Scales, scalesSrc);
+      bool gatherColors = gatherVersions.gatherRequired(gatherVersions.Colors, colorsSrc);
+      bool gatherIds = gatherVersions.gatherRequired(gatherVersions.Ids, paramData.primitiveIds); // Always filled, since indices implies necessity for invisibleIds, and therefore also an Id array
+      bool gatherAttribs[MAX_ATTRIBS] = { false };
+      bool gatherAnyAttrib = false;
       for(size_t attribIdx = 0; attribIdx < attribDataArrays.size(); ++attribIdx)
       {
-        tempArrays->resetAttributeDataArray(attribIdx, attributeArray[attribIdx].PerPrimData ? numVertices : 0);
+        const UsdDataArray* attribSrc = (attributeArray[attribIdx].Data && attributeArray[attribIdx].PerPrimData) ? paramData.primitiveAttributes[attribIdx] : nullptr;
+        if(gatherVersions.gatherRequired(gatherVersions.Attributes[attribIdx], attribSrc))
+        {
+          tempArrays->resetAttributeDataArray(attribIdx, attribSrc ? numVertices : 0);
+          gatherAttribs[attribIdx] = (attribSrc != nullptr);
+          gatherAnyAttrib = gatherAnyAttrib || gatherAttribs[attribIdx];
+        }
       }
 
-      const void* indices = paramData.indices->getData();
-      uint64_t numIndices = paramData.indices->getLayout().numItems1;
-      ANARIDataType indexType = paramData.indices->getType();
+      if (gatherNormals)
+        tempArrays->NormalsArray.resize(normalsSrc ? numVertices*3 : 0);
+      if (gatherScales)
+        tempArrays->ScalesArray.resize(scalesSrc ? numVertices : 0);
+      if (gatherColors)
+        tempArrays->resetColorsArray(colorsSrc ? numVertices : 0, colorsSrc ? colorsSrc->getType() : ANARI_UINT8);
+      if (gatherIds)
+        tempArrays->IdsArray.assign(numVertices, -1);
 
-      int64_t maxId = -1;
-      for (uint64_t primIdx = 0; primIdx < numIndices; ++primIdx)
-      {
-        size_t vertIdx = getIndex(indices, indexType, primIdx);
+      gatherNormals = gatherNormals && normalsSrc;
+      gatherScales = gatherScales && scalesSrc;
+      gatherColors = gatherColors && colorsSrc;
 
-        // Normals
-        if (perPrimNormals)
-        {
-          float* normalsDest = &tempArrays->NormalsArray[vertIdx * 3];
-          getValues2(paramData.primitiveNormals->getData(), paramData.primitiveNormals->getType(), primIdx, normalsDest);
-        }
+      if (!(gatherNormals || gatherScales || gatherColors || gatherIds || gatherAnyAttrib))
+        return;
 
-        // Scales
-        if (perPrimScales)
-        {
-          float* scalesDest = &tempArrays->ScalesArray[vertIdx];
-          getValues2(paramData.primitiveRadii->getData(), paramData.primitiveRadii->getType(), primIdx, scalesDest);
-        }
+      const void* indices = paramData.indices->getData();
+      uint64_t numIndices = paramData.indices->getLayout().numItems1;
+      ANARIDataType indexType = paramData.indices->getType();
 
-        // Colors 
-        if (perPrimColors)
-        {
-          assert(primIdx < paramData.primitiveColors->getLayout().numItems1);
-          tempArrays->copyToColorsArray(paramData.primitiveColors->getData(), primIdx, vertIdx, 1);
-        }
+      // Gather per-prim data in parallel chunks of the index array.
+      // Duplicate indices (which make no sense for spheres) result in an arbitrary one of the prims being written.
+      size_t numChunks = UsdBridgeNumParallelChunks(numIndices);
+      std::vector<int64_t> chunkMaxIds(numChunks, -1);
 
-        // Attributes
-        for(size_t attribIdx = 0; attribIdx < attribDataArrays.size(); ++attribIdx)
+      UsdBridgeParallelFor(numIndices, numChunks,
+        [&](size_t chunkIdx, size_t begin, size_t end)
         {
-          if(attributeArray[attribIdx].PerPrimData)
-          { 
-            tempArrays->copyToAttributeDataArray(attribIdx, primIdx, vertIdx, 1);
+          int64_t maxId = -1;
+          for (uint64_t primIdx = begin; primIdx < end; ++primIdx)
+          {
+            size_t vertIdx = getIndex(indices, indexType, primIdx);
+            assert(vertIdx < numVertices);
+
+            // Normals
+            if (gatherNormals)
+            {
+              float* normalsDest = &tempArrays->NormalsArray[vertIdx * 3];
+              getValues3(normalsSrc->getData(), normalsSrc->getType(), primIdx, normalsDest);
+            }
+
+            // Scales
+            if (gatherScales)
+            {
+              float* scalesDest = &tempArrays->ScalesArray[vertIdx];
+              getValues1(scalesSrc->getData(), scalesSrc->getType(), primIdx, scalesDest);
+            }
+
+            // Colors
+            if (gatherColors)
+            {
+              assert(primIdx < colorsSrc->getLayout().numItems1);
+              tempArrays->copyToColorsArray(colorsSrc->getData(), primIdx, vertIdx, 1);
+            }
+
+            // Attributes
+            for(size_t attribIdx = 0; gatherAnyAttrib && attribIdx < attribDataArrays.size(); ++attribIdx)
+            {
+              if(gatherAttribs[attribIdx])
+              {
+                tempArrays->copyToAttributeDataArray(attribIdx, primIdx, vertIdx, 1);
+              }
+            }
+
+            // Ids
+            if (gatherIds)
+            {
+              int64_t id = paramData.primitiveIds
+                ? static_cast<int64_t>(getIndex(paramData.primitiveIds->getData(), paramData.primitiveIds->getType(), primIdx))
+                : static_cast<int64_t>(vertIdx);
+              tempArrays->IdsArray[vertIdx] = id;
+              if (id > maxId)
+                maxId = id;
+            }
           }
-        }
+          chunkMaxIds[chunkIdx] = maxId;
+        });
 
-        // Ids
-        if (paramData.primitiveIds)
-        {
-          int64_t id = static_cast<int64_t>(getIndex(paramData.primitiveIds->getData(), paramData.primitiveIds->getType(), primIdx));
-          tempArrays->IdsArray[vertIdx] = id;
-          if (id > maxId)
-            maxId = id;
-        }
-        else
-        {
-          int64_t id = static_cast<int64_t>(vertIdx);
-          maxId = tempArrays->IdsArray[vertIdx] = id;
-        }
-      }
-
-      // Assign unused ids to untouched vertices, then add those ids to invisible array
-      tempArrays->InvisIdsArray.resize(0);
-      tempArrays->InvisIdsArray.reserve(numVertices);
-
-      for (uint64_t vertIdx = 0; vertIdx < numVertices; ++vertIdx)
+      if (gatherIds)
       {
-        if (tempArrays->IdsArray[vertIdx] == -1)
-        {
-          tempArrays->IdsArray[vertIdx] = ++maxId;
-          tempArrays->InvisIdsArray.push_back(maxId);
-        }
+        // Assign unused ids to untouched vertices, then add those ids to invisible array
+        int64_t maxId = *std::max_element(chunkMaxIds.begin(), chunkMaxIds.end());
+
+        std::vector<int64_t>& idsArray = tempArrays->IdsArray;
+        size_t numVertChunks = UsdBridgeNumParallelChunks(numVertices);
+        std::vector<uint64_t> chunkInvisOffsets(numVertChunks, 0);
+
+        UsdBridgeParallelFor(numVertices, numVertChunks,
+          [&idsArray, &chunkInvisOffsets](size_t chunkIdx, size_t begin, size_t end)
+          {
+            chunkInvisOffsets[chunkIdx] = std::count(idsArray.begin()+begin, idsArray.begin()+end, -1);
+          });
+
+        uint64_t numInvisIds = UsdBridgeExclusivePrefixSum(chunkInvisOffsets);
+        tempArrays->InvisIdsArray.resize(numInvisIds);
+        std::vector<int64_t>& invisIdsArray = tempArrays->InvisIdsArray;
+
+        UsdBridgeParallelFor(numVertices, numVertChunks,
+          [&idsArray, &invisIdsArray, &chunkInvisOffsets, maxId](size_t chunkIdx, size_t begin, size_t end)
+          {
+            uint64_t invisIdx = chunkInvisOffsets[chunkIdx];
+            for (size_t vertIdx = begin; vertIdx < end; ++vertIdx)
+            {
+              if (idsArray[vertIdx] == -1)
+              {
+                int64_t id = maxId + 1 + static_cast<int64_t>(invisIdx);
+                idsArray[vertIdx] = id;
+                invisIdsArray[invisIdx++] = id;
+              }
+            }
+          });
       }
     }
   }
@@ -447,60 +554,49 @@ namespace
     }
   }
 
-  void pushVertex(const UsdGeometryData& paramData, const UsdGeometry::AttributeArray& attributeArray, UsdGeometryTempArrays* tempArrays,
+  void writeCurveVertex(const UsdGeometryData& paramData, const UsdGeometry::AttributeArray& attributeArray, UsdGeometryTempArrays* tempArrays,
     const void* vertices, ANARIDataType vertexType,
     bool hasNormals, bool hasColors, bool hasRadii,
-    size_t segStart, size_t primIdx)
+    size_t vertIdx, size_t primIdx, size_t destIdx)
   {
     auto& attribDataArrays = tempArrays->AttributeDataArrays;
 
-    float point[3];
-    getValues3(vertices, vertexType, segStart, point);
-    tempArrays->PointsArray.push_back(point[0]);
-    tempArrays->PointsArray.push_back(point[1]);
-    tempArrays->PointsArray.push_back(point[2]);
+    getValues3(vertices, vertexType, vertIdx, &tempArrays->PointsArray[destIdx * 3]);
 
     // Normals
     if (hasNormals)
     {
-      float normals[3];
+      float* normalsDest = &tempArrays->NormalsArray[destIdx * 3];
       if (paramData.vertexNormals)
       {
-        getValues3(paramData.vertexNormals->getData(), paramData.vertexNormals->getType(), segStart, normals);
+        getValues3(paramData.vertexNormals->getData(), paramData.vertexNormals->getType(), vertIdx, normalsDest);
       }
       else if (paramData.primitiveNormals)
       {
-        getValues3(paramData.primitiveNormals->getData(), paramData.primitiveNormals->getType(), primIdx, normals);
+        getValues3(paramData.primitiveNormals->getData(), paramData.primitiveNormals->getType(), primIdx, normalsDest);
       }
-
-      tempArrays->NormalsArray.push_back(normals[0]);
-      tempArrays->NormalsArray.push_back(normals[1]);
-      tempArrays->NormalsArray.push_back(normals[2]);
     }
 
     // Radii
     if (hasRadii)
     {
-      float radii;
+      float* scalesDest = &tempArrays->ScalesArray[destIdx];
       if (paramData.vertexRadii)
       {
-        getValues1(paramData.vertexRadii->getData(), paramData.vertexRadii->getType(), segStart, &radii);
+        getValues1(paramData.vertexRadii->getData(), paramData.vertexRadii->getType(), vertIdx, scalesDest);
       }
       else if (paramData.primitiveRadii)
       {
-        getValues1(paramData.primitiveRadii->getData(), paramData.primitiveRadii->getType(), primIdx, &radii);
+        getValues1(paramData.primitiveRadii->getData(), paramData.primitiveRadii->getType(), primIdx, scalesDest);
       }
-
-      tempArrays->ScalesArray.push_back(radii);
     }
 
     // Colors
     if (hasColors)
     {
-      size_t destIdx = tempArrays->expandColorsArray(1);
       if (paramData.vertexColors)
       {
-        tempArrays->copyToColorsArray(paramData.vertexColors->getData(), segStart, destIdx, 1);
+        tempArrays->copyToColorsArray(paramData.vertexColors->getData(), vertIdx, destIdx, 1);
       }
       else if (paramData.primitiveColors)
       {
@@ -511,18 +607,11 @@ namespace
     // Attributes
     for(size_t attribIdx = 0; attribIdx < attribDataArrays.size(); ++attribIdx)
     {
-      size_t srcIdx = attributeArray[attribIdx].PerPrimData ? primIdx : segStart;
-      size_t destIdx = tempArrays->expandAttributeDataArray(attribIdx, 1);
+      size_t srcIdx = attributeArray[attribIdx].PerPrimData ? primIdx : vertIdx;
       tempArrays->copyToAttributeDataArray(attribIdx, srcIdx, destIdx, 1);
     }
   }
 
-#define PUSH_VERTEX(x, y) \
-  pushVertex(paramData, attributeArray, tempArrays, \
-    vertices, vertexType, \
-    hasNormals, hasColors, hasRadii, \
-    x, y)
-
   void reorderCurveGeometry(const UsdGeometryData& paramData, const UsdGeometry::AttributeArray& attributeArray, UsdGeometryTempArrays* tempArrays)
   {
     auto& attribDataArrays = tempArrays->AttributeDataArrays;
@@ -534,99 +623,116 @@ namespace
     ANARIDataType vertexType = vertexArray->getType();
 
     const UsdDataArray* indexArray = paramData.indices;
-    uint64_t numSegments = indexArray ? indexArray->getLayout().numItems1 : numVertices-1;
+    uint64_t numSegments = indexArray ? indexArray->getLayout().numItems1 : (numVertices ? numVertices-1 : 0);
     const void* indices = indexArray ? indexArray->getData() : nullptr;
     ANARIDataType indexType = indexArray ? indexArray->getType() : ANARI_UINT32;
 
-    uint64_t maxNumVerts = numSegments*2;
-    tempArrays->CurveLengths.resize(0);
-    tempArrays->PointsArray.resize(0);
-    tempArrays->PointsArray.reserve(maxNumVerts * 3); // Conservative max number of points
+    // A segment starts a new strand if its begin vertex is not the end vertex of the previous segment.
+    // Every segment outputs its begin vertex, every strand additionally outputs the end vertex of its last segment.
+    auto segmentStart = [indices, indexType](size_t primIdx) -> size_t
+      { return indices ? getIndex(indices, indexType, primIdx) : primIdx; };
+    auto isStrandStart = [&segmentStart](size_t primIdx) -> bool
+      { return primIdx == 0 || segmentStart(primIdx) != segmentStart(primIdx-1) + 1; };
+
+    // Pass 1: count the strands starting within each chunk of segments
+    size_t numChunks = UsdBridgeNumParallelChunks(numSegments);
+    std::vector<uint64_t> chunkStrandOffsets(numChunks, 0);
+
+    UsdBridgeParallelFor(numSegments, numChunks,
+      [&chunkStrandOffsets, &isStrandStart](size_t chunkIdx, size_t begin, size_t end)
+      {
+        uint64_t numStrands = 0;
+        for (size_t primIdx = begin; primIdx < end; ++primIdx)
+          numStrands += isStrandStart(primIdx) ? 1 : 0;
+        chunkStrandOffsets[chunkIdx] = numStrands;
+      });
+
+    uint64_t numStrands = UsdBridgeExclusivePrefixSum(chunkStrandOffsets);
+    uint64_t numCurveVerts = numSegments + numStrands;
+
+    // Size all output arrays exactly once
+    tempArrays->CurveLengths.resize(numStrands);
+    tempArrays->StrandStarts.resize(numStrands);
+    tempArrays->PointsArray.resize(numCurveVerts * 3);
     bool hasNormals = paramData.vertexNormals || paramData.primitiveNormals;
-    if (hasNormals)
-    {
-      tempArrays->NormalsArray.resize(0);
-      tempArrays->NormalsArray.reserve(maxNumVerts * 3);
-    }
+    tempArrays->NormalsArray.resize(hasNormals ? numCurveVerts * 3 : 0);
     bool hasColors = paramData.vertexColors || paramData.primitiveColors;
     if (hasColors)
-    {
-      tempArrays->resetColorsArray(0, paramData.vertexColors ? paramData.vertexColors->getType() : paramData.primitiveColors->getType());
-      tempArrays->reserveColorsArray(maxNumVerts);
-    }
+      tempArrays->resetColorsArray(numCurveVerts, paramData.vertexColors ? paramData.vertexColors->getType() : paramData.primitiveColors->getType());
+    else
+      tempArrays->ColorsArray.resize(0);
     bool hasRadii = paramData.vertexRadii || paramData.primitiveRadii;
-    if (hasRadii)
-    {
-      tempArrays->ScalesArray.resize(0);
-      tempArrays->ScalesArray.reserve(maxNumVerts);
-    }
+    tempArrays->ScalesArray.resize(hasRadii ? numCurveVerts : 0);
     for(size_t attribIdx = 0; attribIdx < attribDataArrays.size(); ++attribIdx)
     {
-      tempArrays->resetAttributeDataArray(attribIdx, 0);
-      tempArrays->reserveAttributeDataArray(attribIdx, maxNumVerts);
+      tempArrays->resetAttributeDataArray(attribIdx, numCurveVerts);
     }
 
-    size_t prevSegEnd = 0;
-    int curveLength = 0;
-    for (size_t primIdx = 0; primIdx < numSegments; ++primIdx)
-    {
-      size_t segStart = indices ? getIndex(indices, indexType, primIdx) : primIdx;
-
-      if (primIdx != 0 && prevSegEnd != segStart)
+    // Pass 2: scatter the vertices of each segment to their final output location
+    UsdBridgeParallelFor(numSegments, numChunks,
+      [&](size_t chunkIdx, size_t begin, size_t end)
       {
-        PUSH_VERTEX(prevSegEnd, primIdx - 1);
-        curveLength += 1;
-        tempArrays->CurveLengths.push_back(curveLength);
-        curveLength = 0;
-      }
+        uint64_t strandIdx = chunkStrandOffsets[chunkIdx]; // Index of next strand to start
+        for (size_t primIdx = begin; primIdx < end; ++primIdx)
+        {
+          size_t segStart = segmentStart(primIdx);
+          assert(segStart+1 < numVertices); // begin and end vertex should be in range
 
-      assert(segStart+1 < numVertices); // begin and end vertex should be in range
+          if (isStrandStart(primIdx))
+          {
+            tempArrays->StrandStarts[strandIdx] = primIdx;
+            ++strandIdx;
+          }
 
-      PUSH_VERTEX(segStart, primIdx);
-      curveLength += 1;
+          // Strands before this segment's strand have each output one extra end vertex
+          size_t destIdx = primIdx + (strandIdx - 1);
+          writeCurveVertex(paramData, attributeArray, tempArrays, vertices, vertexType,
+            hasNormals, hasColors, hasRadii, segStart, primIdx, destIdx);
 
-      prevSegEnd = segStart + 1;
-    }
-    if (curveLength != 0)
-    {
-      PUSH_VERTEX(prevSegEnd, numSegments - 1);
-      curveLength += 1;
-      tempArrays->CurveLengths.push_back(curveLength);
-    }
+          if (primIdx+1 == numSegments || isStrandStart(primIdx+1))
+          {
+            writeCurveVertex(paramData, attributeArray, tempArrays, vertices, vertexType,
+              hasNormals, hasColors, hasRadii, segStart+1, primIdx, destIdx+1);
+          }
+        }
+      });
+
+    // Curve lengths follow from the segment distance between consecutive strand starts
+    const std::vector<uint64_t>& strandStarts = tempArrays->StrandStarts;
+    std::vector<int>& curveLengths = tempArrays->CurveLengths;
+    UsdBridgeParallelFor(numStrands,
+      [&strandStarts, &curveLengths, numStrands, numSegments](size_t chunkIdx, size_t begin, size_t end)
+      {
+        for (size_t strandIdx = begin; strandIdx < end; ++strandIdx)
+        {
+          uint64_t strandEnd = (strandIdx+1 < numStrands) ? strandStarts[strandIdx+1] : numSegments;
+          curveLengths[strandIdx] = static_cast<int>(strandEnd - strandStarts[strandIdx] + 1);
+        }
+      });
   }
 }
 
 UsdGeometry::UsdGeometry(const char* name, const char* type, UsdBridge* bridge, UsdDevice* device)
   : BridgedBaseObjectType(ANARI_GEOMETRY, name, bridge)
 {
-  bool createTempArrays = false;
-
   if (strEquals(type, "sphere"))
+  {
     geomType = GEOM_SPHERE;
+    // Gathered indexed sphere data is kept around, so unchanged streams don't have to be gathered again
+    cachedTempArrays = std::make_unique<UsdGeometryTempArrays>(&attributeArray);
+  }
   else if (strEquals(type, "cylinder"))
-  {
     geomType = GEOM_CYLINDER;
-    createTempArrays = true;
-  }
   else if (strEquals(type, "cone"))
-  {
     geomType = GEOM_CONE;
-    createTempArrays = true;
-  }
   else if (strEquals(type, "curve"))
-  {
     geomType = GEOM_CURVE;
-    createTempArrays = true;
-  }
   else if(strEquals(type, "triangle"))
     geomType = GEOM_TRIANGLE;
   else if (strEquals(type, "quad"))
     geomType = GEOM_QUAD;
   else
     device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_ERROR, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' construction failed: type %s not supported", getName(), name);
-
-  if(createTempArrays)
-    tempArrays = std::make_unique<UsdGeometryTempArrays>(attributeArray);
 }
 
 UsdGeometry::~UsdGeometry()
@@ -680,9 +786,12 @@ void UsdGeometry::syncAttributeArrays()
   }
 
   // Set the attribute arrays and related info, resize temporary attribute array data for reordering
+  attributeArray.resize(attribCount);
+  if(tempArrays)
+    tempArrays->resizeAttributeDataArrays(attribCount);
+
   if(attribCount)
   {
-    attributeArray.resize(attribCount);
     for(int i = 0; i < attribCount; ++i)
     {
       const UsdDataArray* attribArray = paramData.vertexAttributes[i] ? paramData.vertexAttributes[i] : paramData.primitiveAttributes[i];
@@ -699,9 +808,6 @@ void UsdGeometry::syncAttributeArrays()
         attributeArray[i].DataType = UsdBridgeType::UNDEFINED;
       }
     }
-
-    if(tempArrays)
-      tempArrays->AttributeDataArrays.resize(attribCount);
   }
 }
 
@@ -994,9 +1100,110 @@ void UsdGeometry::updateGeomData(UsdDevice* device, UsdBridgeMeshData& meshData)
 
   //meshData.UpdatesToPerform = Still to be implemented
 
+  // Referred to by meshData after reordering, so has to outlive the writes below
+  UsdGeometryReorderedMesh reorderedMesh;
+  if (paramData.reorder)
+  {
+    if (!indices)
+      device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' has 'usd::reorder' set, which is only supported for indexed meshes.", getName());
+    else if (!ReorderMeshForLocality(meshData, reorderedMesh))
+      device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' has 'usd::reorder' set, but its mesh data cannot be reordered (out of range indices or too many vertices).", getName());
+  }
+
   double worldTimeStep = device->getReadParams().timeStep;
   double dataTimeStep = selectObjTime(paramData.timeStep, worldTimeStep);
-  usdBridge->SetGeometryData(usdHandle, meshData, dataTimeStep);
+
+  // Simplify while the full-resolution mesh is written out
+  std::vector<float> lodRatios;
+  getLodRatios(device, lodRatios);
+
+  std::vector<UsdGeometryLod> lods;
+  bool lodsGenerated = false;
+  std::thread lodThread;
+  if(lodRatios.size())
+  {
+    lodThread = std::thread([&meshData, &lodRatios, &lods, &lodsGenerated]()
+      {
+        lodsGenerated = GenerateMeshLods(meshData, lodRatios.data(), lodRatios.size(), lods);
+      });
+  }
+
+  setBridgeGeomData(device, meshData, dataTimeStep);
+
+  if(lodThread.joinable())
+  {
+    lodThread.join();
+    if(!lodsGenerated)
+      device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' has 'usd::lod.levels' set, but its mesh data cannot be simplified (out of range indices or too many vertices).", getName());
+  }
+
+  std::vector<UsdBridgeMeshData> lodData;
+  for(const UsdGeometryLod& lod : lods)
+    lodData.push_back(lod.MeshData);
+  usdBridge->SetGeometryLods(usdHandle, lodData.data(), uint32_t(lodData.size()), dataTimeStep);
+}
+
+void UsdGeometry::getLodRatios(UsdDevice* device, std::vector<float>& lodRatios)
+{
+  const UsdGeometryData& paramData = getReadParams();
+  const UsdDataArray* lodLevels = paramData.lodLevels;
+  if(!lodLevels)
+    return;
+
+  const char* debugName = getName();
+  if(geomType != GEOM_TRIANGLE)
+  {
+    device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' has 'usd::lod.levels' set, which is only supported for triangle geometry.", debugName);
+    return;
+  }
+  if(lodLevels->getType() != ANARI_FLOAT32)
+  {
+    device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_ERROR, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' commit failed: 'usd::lod.levels' parameter should be of type ANARI_FLOAT32.", debugName);
+    return;
+  }
+
+  const float* ratios = static_cast<const float*>(lodLevels->getData());
+  uint64_t numRatios = lodLevels->getLayout().numItems1;
+  for(uint64_t i = 0; i < numRatios; ++i)
+  {
+    if(ratios[i] > 0.0f && ratios[i] < 1.0f)
+      lodRatios.push_back(ratios[i]);
+    else
+      device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' ignores 'usd::lod.levels' entry %f, ratios should be within (0,1).", debugName, ratios[i]);
+  }
+
+  // Levels are simplified from one another, so go from fine to coarse
+  std::sort(lodRatios.begin(), lodRatios.end(), std::greater<float>());
+  lodRatios.erase(std::unique(lodRatios.begin(), lodRatios.end()), lodRatios.end());
+}
+
+template<typename GeomDataType>
+void UsdGeometry::setBridgeGeomData(UsdDevice* device, const GeomDataType& geomData, double dataTimeStep)
+{
+  uint64_t chunkSize = device->getReadParams().chunkSize;
+  if(isChunked || (chunkSize && getNumChunkablePrims(geomData) > chunkSize))
+  {
+    // A chunked geometry prim has no data of its own anymore, so keep writing chunks even if chunking gets disabled
+    std::vector<UsdGeometryChunk<GeomDataType>> chunks;
+    if(PartitionGeometry(geomData, chunkSize ? chunkSize : std::numeric_limits<uint64_t>::max(), chunks))
+    {
+      std::vector<GeomDataType> chunkData;
+      for(const UsdGeometryChunk<GeomDataType>& chunk : chunks)
+        chunkData.push_back(chunk.GeomData);
+      usdBridge->SetGeometryChunks(usdHandle, chunkData.data(), uint32_t(chunkData.size()), dataTimeStep);
+      isChunked = true;
+      return;
+    }
+
+    if(isChunked)
+    {
+      device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_ERROR, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' commit failed: its data cannot be partitioned into chunks (out of range indices or too many vertices).", getName());
+      return;
+    }
+    device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' exceeds 'usd::chunkSize', but its data cannot be partitioned into chunks (out of range indices or too many vertices).", getName());
+  }
+
+  usdBridge->SetGeometryData(usdHandle, geomData, dataTimeStep);
 }
 
 void UsdGeometry::updateGeomData(UsdDevice* device, UsdBridgeInstancerData& instancerData)
@@ -1011,7 +1218,7 @@ void UsdGeometry::updateGeomData(UsdDevice* device, UsdBridgeInstancerData& inst
     // - Duplicate spheres make no sense
     // Instead, Ids/InvisibleIds are used to emulate sparsely indexed spheres (sourced from paramData.primitiveIds if available),
     // and any per-prim arrays are explicitly converted to per-vertex via the tempArrays.
-    generateIndexedSphereData(paramData, attributeArray, tempArrays.get());
+    generateIndexedSphereData(paramData, attributeArray, tempArrays);
 
     const UsdDataArray* vertices = paramData.vertexPositions;
     instancerData.NumPoints = vertices->getLayout().numItems1;
@@ -1131,7 +1338,7 @@ void UsdGeometry::updateGeomData(UsdDevice* device, UsdBridgeInstancerData& inst
   }
   else
   {
-    convertLinesToSticks(paramData, attributeArray, tempArrays.get());
+    convertLinesToSticks(paramData, attributeArray, tempArrays);
 
     instancerData.NumPoints = tempArrays->PointsArray.size()/3;
     if (instancerData.NumPoints > 0)
@@ -1169,14 +1376,14 @@ void UsdGeometry::updateGeomData(UsdDevice* device, UsdBridgeInstancerData& inst
 
   double worldTimeStep = device->getReadParams().timeStep;
   double dataTimeStep = selectObjTime(paramData.timeStep, worldTimeStep);
-  usdBridge->SetGeometryData(usdHandle, instancerData, dataTimeStep);
+  setBridgeGeomData(device, instancerData, dataTimeStep);
 }
 
 void UsdGeometry::updateGeomData(UsdDevice* device, UsdBridgeCurveData& curveData)
 {
   const UsdGeometryData& paramData = getReadParams();
 
-  reorderCurveGeometry(paramData, attributeArray, tempArrays.get());
+  reorderCurveGeometry(paramData, attributeArray, tempArrays);
 
   curveData.NumPoints = tempArrays->PointsArray.size() / 3;
   if (curveData.NumPoints > 0)
@@ -1226,6 +1433,8 @@ void UsdGeometry::commitTemplate(UsdDevice* device)
 
   UsdGeomType geomData;
 
+  acquireTempArrays(device);
+
   syncAttributeArrays();
   initializeGeomData(geomData);
   copyAttributeArraysToData(geomData);
@@ -1250,6 +1459,25 @@ void UsdGeometry::commitTemplate(UsdDevice* device)
   
     paramChanged = false;
   }
+
+  releaseTempArrays(device);
+}
+
+void UsdGeometry::acquireTempArrays(UsdDevice* device)
+{
+  // Other than the cached sphere data, temp arrays are only required for the duration of a commit,
+  // so they are borrowed from the device instead of being kept alive per geometry.
+  if(cachedTempArrays)
+    tempArrays = cachedTempArrays.get();
+  else if(geomType == GEOM_CYLINDER || geomType == GEOM_CONE || geomType == GEOM_CURVE)
+    tempArrays = device->getGeometryScratchArena()->acquire(&attributeArray);
+}
+
+void UsdGeometry::releaseTempArrays(UsdDevice* device)
+{
+  if(tempArrays && tempArrays != cachedTempArrays.get())
+    device->getGeometryScratchArena()->release();
+  tempArrays = nullptr;
 }
 
 bool UsdGeometry::deferCommit(UsdDevice* device)
@@ -1275,3 +1503,76 @@ bool UsdGeometry::doCommitData(UsdDevice* device)
 
   return false;
 }
+
+UsdGeometryScratchArena::UsdGeometryScratchArena()
+  : tempArrays(std::make_unique<UsdGeometryTempArrays>(&noAttributes))
+{
+}
+
+UsdGeometryScratchArena::~UsdGeometryScratchArena()
+{
+}
+
+UsdGeometryTempArrays* UsdGeometryScratchArena::acquire(const UsdGeometry::AttributeArray* attributes)
+{
+  assert(!acquired); // Geometry commits are serialized by the device, so there is only a single borrower at a time
+  acquired = true;
+
+  tempArrays->Attributes = attributes;
+  return tempArrays.get();
+}
+
+void UsdGeometryScratchArena::release()
+{
+  assert(acquired);
+  acquired = false;
+
+  // Track the high-water mark of each buffer in between trims
+  size_t bufferIdx = 0;
+  tempArrays->forEachBuffer([this, &bufferIdx](const auto& buffer)
+    {
+      if(bufferIdx == highWaterBytes.size())
+        highWaterBytes.push_back(0);
+      highWaterBytes[bufferIdx] = std::max(highWaterBytes[bufferIdx], buffer.size()*sizeof(buffer[0]));
+      ++bufferIdx;
+    });
+
+  tempArrays->Attributes = &noAttributes;
+}
+
+void UsdGeometryScratchArena::trim(uint64_t memoryLimit)
+{
+  assert(!acquired);
+
+  size_t reservedBytes = 0;
+  tempArrays->forEachBuffer([&reservedBytes](const auto& buffer)
+    {
+      reservedBytes += buffer.capacity()*sizeof(buffer[0]);
+    });
+
+  if(reservedBytes > memoryLimit)
+  {
+    // Shrink all buffers to their high-water mark since the last trim,
+    // or release them altogether if that still doesn't fit within the limit.
+    size_t highWaterTotal = 0;
+    for(size_t bufferBytes : highWaterBytes)
+      highWaterTotal += bufferBytes;
+    bool keepHighWater = highWaterTotal <= memoryLimit;
+
+    size_t bufferIdx = 0;
+    tempArrays->forEachBuffer([this, &bufferIdx, keepHighWater](auto& buffer)
+      {
+        size_t keepBytes = (keepHighWater && bufferIdx < highWaterBytes.size()) ? highWaterBytes[bufferIdx] : 0;
+        size_t keepElts = keepBytes / sizeof(buffer[0]);
+        if(buffer.capacity() > keepElts)
+        {
+          typename std::decay<decltype(buffer)>::type shrunkBuffer;
+          shrunkBuffer.reserve(keepElts);
+          buffer.swap(shrunkBuffer);
+        }
+        ++bufferIdx;
+      });
+  }
+
+  highWaterBytes.clear();
+}
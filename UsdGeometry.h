@@ -44,6 +44,12 @@ struct UsdGeometryData
   const UsdDataArray* primitiveRadii = nullptr;
 
   // Curves
+
+  // Triangles
+  const UsdDataArray* lodLevels = nullptr; // Triangle count ratios of the reduced-resolution levels
+
+  // Triangles and quads
+  bool reorder = false; // Reorder faces and vertices of indexed meshes for vertex cache locality
 };
 
 struct UsdGeometryTempArrays;
@@ -101,6 +107,11 @@ class UsdGeometry : public UsdBridgedBaseObject<UsdGeometry, UsdGeometryData, Us
     void updateGeomData(UsdDevice* device, UsdBridgeInstancerData& instancerData);
     void updateGeomData(UsdDevice* device, UsdBridgeCurveData& curveData);
 
+    void getLodRatios(UsdDevice* device, std::vector<float>& lodRatios);
+
+    template<typename GeomDataType>
+    void setBridgeGeomData(UsdDevice* device, const GeomDataType& geomData, double dataTimeStep);
+
     template<typename UsdGeomType>
     void commitTemplate(UsdDevice* device);
 
@@ -114,9 +125,36 @@ class UsdGeometry : public UsdBridgedBaseObject<UsdGeometry, UsdGeometryData, Us
 
     void assignTempDataToAttributes(bool perPrimInterpolation);
 
+    void acquireTempArrays(UsdDevice* device);
+    void releaseTempArrays(UsdDevice* device);
+
     GeomType geomType = GEOM_UNKNOWN;
 
-    std::unique_ptr<UsdGeometryTempArrays> tempArrays;
+    std::unique_ptr<UsdGeometryTempArrays> cachedTempArrays; // Only for geometry types that reuse converted data across commits
+    UsdGeometryTempArrays* tempArrays = nullptr; // Valid during commit
 
     AttributeArray attributeArray;
+
+    bool isChunked = false; // Once written as chunks, all later data is written as chunks as well
+};
+
+// Scratch memory for geometry conversion, shared by all geometries of a device.
+// Reused across commits, and trimmed after each flush of the commit list according to a memory limit.
+class UsdGeometryScratchArena
+{
+  public:
+    UsdGeometryScratchArena();
+    ~UsdGeometryScratchArena();
+
+    UsdGeometryTempArrays* acquire(const UsdGeometry::AttributeArray* attributes); // Valid until release()
+    void release();
+
+    void trim(uint64_t memoryLimit);
+
+  protected:
+    std::unique_ptr<UsdGeometryTempArrays> tempArrays;
+    std::vector<size_t> highWaterBytes; // Per buffer, since last trim
+    bool acquired = false;
+
+    const UsdGeometry::AttributeArray noAttributes;
 };
\ No newline at end of file
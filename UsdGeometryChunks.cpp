@@ -0,0 +1,268 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "UsdGeometryChunks.h"
+#include "UsdGeometryGather.h"
+#include "UsdBridgeUtils.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+  static constexpr uint32_t InvalidId = ~uint32_t(0);
+
+  using ChunkRange = std::pair<size_t, size_t>;
+
+  const float* getPositions(const void* points, UsdBridgeType pointsType, uint64_t numPoints, std::vector<float>& convertedPositions)
+  {
+    if(pointsType == UsdBridgeType::FLOAT3)
+      return static_cast<const float*>(points);
+
+    if(pointsType == UsdBridgeType::DOUBLE3)
+    {
+      const double* srcPositions = static_cast<const double*>(points);
+      convertedPositions.resize(3*numPoints);
+      for(size_t i = 0; i < convertedPositions.size(); ++i)
+        convertedPositions[i] = float(srcPositions[i]);
+      return convertedPositions.data();
+    }
+
+    return nullptr;
+  }
+
+  size_t numChunkThreads(size_t numChunks)
+  {
+    return std::min(numChunks, UsdBridgeNumWorkerThreads());
+  }
+
+  // Orders the elements by recursive median splits of their centers, into ranges of at most chunkSize elements.
+  // Within a range, elements keep their input order.
+  void partitionCenters(const float* centers, size_t numElts, uint64_t chunkSize, std::vector<uint32_t>& order, std::vector<ChunkRange>& ranges)
+  {
+    order.resize(numElts);
+    std::iota(order.begin(), order.end(), 0u);
+    ranges.clear();
+
+    std::vector<ChunkRange> splitStack(1, ChunkRange(0, numElts));
+    while(!splitStack.empty())
+    {
+      ChunkRange range = splitStack.back();
+      splitStack.pop_back();
+
+      size_t numRangeElts = range.second - range.first;
+      if(numRangeElts <= chunkSize)
+      {
+        ranges.push_back(range);
+        continue;
+      }
+
+      float minBound[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+      float maxBound[3] = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+      for(size_t i = range.first; i < range.second; ++i)
+      {
+        const float* center = centers + 3*order[i];
+        for(int axis = 0; axis < 3; ++axis)
+        {
+          minBound[axis] = std::min(minBound[axis], center[axis]);
+          maxBound[axis] = std::max(maxBound[axis], center[axis]);
+        }
+      }
+      int splitAxis = 0;
+      for(int axis = 1; axis < 3; ++axis)
+      {
+        if(maxBound[axis] - minBound[axis] > maxBound[splitAxis] - minBound[splitAxis])
+          splitAxis = axis;
+      }
+
+      // The lower half gets half of the chunks, all of them full
+      size_t numRangeChunks = (numRangeElts + chunkSize - 1) / chunkSize;
+      size_t mid = range.first + (numRangeChunks/2)*chunkSize;
+      std::nth_element(order.begin()+range.first, order.begin()+mid, order.begin()+range.second,
+        [centers, splitAxis](uint32_t lhs, uint32_t rhs) { return centers[3*lhs+splitAxis] < centers[3*rhs+splitAxis]; });
+
+      // Upper half is pushed first, so ranges are output in order
+      splitStack.push_back(ChunkRange(mid, range.second));
+      splitStack.push_back(ChunkRange(range.first, mid));
+    }
+
+    UsdBridgeParallelFor(ranges.size(), numChunkThreads(ranges.size()), [&order, &ranges](size_t, size_t begin, size_t end)
+      {
+        for(size_t rangeIdx = begin; rangeIdx < end; ++rangeIdx)
+          std::sort(order.begin()+ranges[rangeIdx].first, order.begin()+ranges[rangeIdx].second);
+      });
+  }
+
+  template<typename GeomDataType>
+  const char* gatherArray(UsdGeometryChunk<GeomDataType>& chunk, const void* srcData, UsdBridgeType dataType, const std::vector<uint32_t>& ids)
+  {
+    // Moving the inner vectors on reallocation keeps their data in place
+    chunk.Arrays.emplace_back();
+    GatherElements(srcData, UsdBridgeTypeSize(dataType), ids, chunk.Arrays.back());
+    return chunk.Arrays.back().data();
+  }
+
+  template<typename GeomDataType>
+  void gatherAttributes(UsdGeometryChunk<GeomDataType>& chunk, const GeomDataType& geomData,
+    const std::vector<uint32_t>& vertexIds, const std::vector<uint32_t>& primIds)
+  {
+    chunk.Attributes.assign(geomData.Attributes, geomData.Attributes + geomData.NumAttributes);
+    for(UsdBridgeAttribute& attrib : chunk.Attributes)
+    {
+      if(attrib.Data)
+        attrib.Data = gatherArray(chunk, attrib.Data, attrib.DataType, attrib.PerPrimData ? primIds : vertexIds);
+    }
+    chunk.GeomData.Attributes = chunk.Attributes.data();
+  }
+}
+
+bool PartitionGeometry(const UsdBridgeMeshData& meshData, uint64_t chunkSize, std::vector<UsdGeometryMeshChunk>& chunks)
+{
+  chunks.clear();
+
+  uint64_t numPoints = meshData.NumPoints;
+  size_t faceSize = size_t(meshData.FaceVertexCount);
+  if(!meshData.Points || !faceSize || !chunkSize || numPoints >= InvalidId)
+    return false;
+
+  std::vector<float> convertedPositions;
+  const float* positions = getPositions(meshData.Points, meshData.PointsType, numPoints, convertedPositions);
+  if(!positions)
+    return false;
+
+  uint64_t numIndices = meshData.Indices ? meshData.NumIndices : numPoints;
+  std::vector<uint32_t> indices(numIndices - numIndices % faceSize);
+  if(meshData.Indices)
+  {
+    if(!CopyIndicesToUint32(meshData.Indices, meshData.IndicesType, numPoints, indices))
+      return false;
+  }
+  else
+    std::iota(indices.begin(), indices.end(), 0u);
+
+  size_t numFaces = indices.size() / faceSize;
+  std::vector<float> centers(3*numFaces);
+  UsdBridgeParallelFor(numFaces, [&indices, &centers, positions, faceSize](size_t, size_t begin, size_t end)
+    {
+      float invFaceSize = 1.0f / float(faceSize);
+      for(size_t faceIdx = begin; faceIdx < end; ++faceIdx)
+      {
+        float* center = centers.data() + 3*faceIdx;
+        for(size_t k = 0; k < faceSize; ++k)
+        {
+          const float* position = positions + 3*indices[faceIdx*faceSize + k];
+          center[0] += position[0]; center[1] += position[1]; center[2] += position[2];
+        }
+        center[0] *= invFaceSize; center[1] *= invFaceSize; center[2] *= invFaceSize;
+      }
+    });
+
+  std::vector<uint32_t> faceOrder;
+  std::vector<ChunkRange> ranges;
+  partitionCenters(centers.data(), numFaces, chunkSize, faceOrder, ranges);
+
+  // Remap the vertices of each chunk, keeping their input order
+  size_t numChunks = ranges.size();
+  chunks.resize(numChunks);
+  std::vector<std::vector<uint32_t>> chunkFaceIds(numChunks);
+  std::vector<std::vector<uint32_t>> chunkVertexIds(numChunks);
+  UsdBridgeParallelFor(numChunks, numChunkThreads(numChunks), [&](size_t, size_t begin, size_t end)
+    {
+      for(size_t chunkIdx = begin; chunkIdx < end; ++chunkIdx)
+      {
+        std::vector<uint32_t>& faceIds = chunkFaceIds[chunkIdx];
+        faceIds.assign(faceOrder.begin()+ranges[chunkIdx].first, faceOrder.begin()+ranges[chunkIdx].second);
+
+        std::vector<uint32_t>& chunkIndices = chunks[chunkIdx].Indices;
+        chunkIndices.resize(faceIds.size()*faceSize);
+        for(size_t i = 0; i < faceIds.size(); ++i)
+        {
+          auto faceBegin = indices.begin() + faceIds[i]*faceSize;
+          std::copy(faceBegin, faceBegin + faceSize, chunkIndices.begin() + i*faceSize);
+        }
+
+        std::vector<uint32_t>& vertexIds = chunkVertexIds[chunkIdx];
+        vertexIds = chunkIndices;
+        std::sort(vertexIds.begin(), vertexIds.end());
+        vertexIds.erase(std::unique(vertexIds.begin(), vertexIds.end()), vertexIds.end());
+
+        for(uint32_t& index : chunkIndices)
+          index = uint32_t(std::lower_bound(vertexIds.begin(), vertexIds.end(), index) - vertexIds.begin());
+      }
+    });
+
+  // Gathers are parallel by themselves
+  for(size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx)
+  {
+    UsdGeometryMeshChunk& chunk = chunks[chunkIdx];
+    const std::vector<uint32_t>& faceIds = chunkFaceIds[chunkIdx];
+    const std::vector<uint32_t>& vertexIds = chunkVertexIds[chunkIdx];
+
+    UsdBridgeMeshData& chunkData = chunk.GeomData;
+    chunkData = meshData;
+    chunkData.NumPoints = vertexIds.size();
+    chunkData.Points = gatherArray(chunk, meshData.Points, meshData.PointsType, vertexIds);
+    if(meshData.Normals)
+      chunkData.Normals = gatherArray(chunk, meshData.Normals, meshData.NormalsType, meshData.PerPrimNormals ? faceIds : vertexIds);
+    if(meshData.Colors)
+      chunkData.Colors = gatherArray(chunk, meshData.Colors, meshData.ColorsType, meshData.PerPrimColors ? faceIds : vertexIds);
+    gatherAttributes(chunk, meshData, vertexIds, faceIds);
+
+    chunkData.Indices = chunk.Indices.data();
+    chunkData.IndicesType = UsdBridgeType::UINT;
+    chunkData.NumIndices = chunk.Indices.size();
+  }
+
+  return true;
+}
+
+bool PartitionGeometry(const UsdBridgeInstancerData& instancerData, uint64_t chunkSize, std::vector<UsdGeometryPointsChunk>& chunks)
+{
+  chunks.clear();
+
+  uint64_t numPoints = instancerData.NumPoints;
+  if(!instancerData.Points || !chunkSize || numPoints >= InvalidId)
+    return false;
+
+  std::vector<float> convertedPositions;
+  const float* positions = getPositions(instancerData.Points, instancerData.PointsType, numPoints, convertedPositions);
+  if(!positions)
+    return false;
+
+  std::vector<uint32_t> pointOrder;
+  std::vector<ChunkRange> ranges;
+  partitionCenters(positions, numPoints, chunkSize, pointOrder, ranges);
+
+  chunks.resize(ranges.size());
+  for(size_t chunkIdx = 0; chunkIdx < ranges.size(); ++chunkIdx)
+  {
+    UsdGeometryPointsChunk& chunk = chunks[chunkIdx];
+    std::vector<uint32_t> pointIds(pointOrder.begin()+ranges[chunkIdx].first, pointOrder.begin()+ranges[chunkIdx].second);
+
+    // Invisible ids refer to instance ids, so they apply to every chunk as-is
+    UsdBridgeInstancerData& chunkData = chunk.GeomData;
+    chunkData = instancerData;
+    if(instancerData.Shapes == &instancerData.DefaultShape)
+      chunkData.Shapes = &chunkData.DefaultShape;
+    chunkData.NumPoints = pointIds.size();
+    chunkData.Points = gatherArray(chunk, instancerData.Points, instancerData.PointsType, pointIds);
+    if(instancerData.ShapeIndices)
+      chunkData.ShapeIndices = reinterpret_cast<const int*>(gatherArray(chunk, instancerData.ShapeIndices, UsdBridgeType::INT, pointIds));
+    if(instancerData.Scales)
+      chunkData.Scales = gatherArray(chunk, instancerData.Scales, instancerData.ScalesType, pointIds);
+    if(instancerData.Orientations)
+      chunkData.Orientations = gatherArray(chunk, instancerData.Orientations, instancerData.OrientationsType, pointIds);
+    if(instancerData.Colors)
+      chunkData.Colors = gatherArray(chunk, instancerData.Colors, instancerData.ColorsType, pointIds);
+    if(instancerData.LinearVelocities)
+      chunkData.LinearVelocities = reinterpret_cast<const float*>(gatherArray(chunk, instancerData.LinearVelocities, UsdBridgeType::FLOAT3, pointIds));
+    if(instancerData.AngularVelocities)
+      chunkData.AngularVelocities = reinterpret_cast<const float*>(gatherArray(chunk, instancerData.AngularVelocities, UsdBridgeType::FLOAT3, pointIds));
+    if(instancerData.InstanceIds)
+      chunkData.InstanceIds = gatherArray(chunk, instancerData.InstanceIds, instancerData.InstanceIdsType, pointIds);
+    gatherAttributes(chunk, instancerData, pointIds, pointIds);
+  }
+
+  return true;
+}
@@ -0,0 +1,32 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "UsdBridgeData.h"
+
+#include <vector>
+
+// Spatially coherent part of a mesh or point cloud. GeomData refers to the buffers owned by this object.
+template<typename GeomDataType>
+struct UsdGeometryChunk
+{
+  GeomDataType GeomData;
+
+  std::vector<std::vector<char>> Arrays; // Gathered per-vertex and per-face data
+  std::vector<uint32_t> Indices;
+  std::vector<UsdBridgeAttribute> Attributes;
+};
+
+using UsdGeometryMeshChunk = UsdGeometryChunk<UsdBridgeMeshData>;
+using UsdGeometryPointsChunk = UsdGeometryChunk<UsdBridgeInstancerData>;
+
+// Partitions a mesh into chunks of at most chunkSize faces, through recursive median splits of the face centers
+// along the longest axis of their bounds. Faces keep their relative order within a chunk. Vertices are remapped per chunk,
+// so vertices shared by faces of different chunks are duplicated.
+// Returns false if the mesh cannot be partitioned (unsupported position or index types, invalid indices).
+bool PartitionGeometry(const UsdBridgeMeshData& meshData, uint64_t chunkSize, std::vector<UsdGeometryMeshChunk>& chunks);
+
+// Partitions a point cloud or instancer into chunks of at most chunkSize points, as done for meshes.
+// Returns false if the points have an unsupported type.
+bool PartitionGeometry(const UsdBridgeInstancerData& instancerData, uint64_t chunkSize, std::vector<UsdGeometryPointsChunk>& chunks);
@@ -0,0 +1,47 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "UsdBridgeData.h"
+#include "UsdBridgeParallel.h"
+
+#include <cstring>
+#include <vector>
+
+// Copies the elements of srcData at ids into dest, in order of ids
+inline void GatherElements(const void* srcData, size_t eltSize, const std::vector<uint32_t>& ids, std::vector<char>& dest)
+{
+  const char* src = static_cast<const char*>(srcData);
+  dest.resize(ids.size()*eltSize);
+  UsdBridgeParallelFor(ids.size(), [src, eltSize, &ids, &dest](size_t, size_t begin, size_t end)
+    {
+      for(size_t i = begin; i < end; ++i)
+        std::memcpy(dest.data() + i*eltSize, src + ids[i]*eltSize, eltSize);
+    });
+}
+
+template<typename IndexType>
+bool CopyIndicesToUint32(const IndexType* src, uint64_t numPoints, std::vector<uint32_t>& indices)
+{
+  for(size_t i = 0; i < indices.size(); ++i)
+  {
+    if(src[i] < 0 || uint64_t(src[i]) >= numPoints)
+      return false;
+    indices[i] = uint32_t(src[i]);
+  }
+  return true;
+}
+
+// Fills indices (sized by the caller) from srcData of indexType, returns false for unsupported types or indices out of range of numPoints
+inline bool CopyIndicesToUint32(const void* srcData, UsdBridgeType indexType, uint64_t numPoints, std::vector<uint32_t>& indices)
+{
+  switch(indexType)
+  {
+    case UsdBridgeType::INT: return CopyIndicesToUint32(static_cast<const int32_t*>(srcData), numPoints, indices);
+    case UsdBridgeType::UINT: return CopyIndicesToUint32(static_cast<const uint32_t*>(srcData), numPoints, indices);
+    case UsdBridgeType::LONG: return CopyIndicesToUint32(static_cast<const int64_t*>(srcData), numPoints, indices);
+    case UsdBridgeType::ULONG: return CopyIndicesToUint32(static_cast<const uint64_t*>(srcData), numPoints, indices);
+    default: return false;
+  }
+}
@@ -0,0 +1,544 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "UsdGeometryLod.h"
+#include "UsdGeometryGather.h"
+#include "UsdBridgeUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  // Boundary edges are kept in place by planes perpendicular to their face, weighted with this factor
+  static constexpr double BoundaryPlaneWeight = 10.0;
+
+  static constexpr uint32_t InvalidVertexId = ~uint32_t(0);
+
+  struct LodQuadric
+  {
+    // Upper triangle of the symmetric 4x4 matrix summing the squared plane equations
+    double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+    double a11 = 0, a12 = 0, a13 = 0;
+    double a22 = 0, a23 = 0;
+    double a33 = 0;
+
+    void addPlane(const double* n, double d, double weight)
+    {
+      a00 += weight*n[0]*n[0]; a01 += weight*n[0]*n[1]; a02 += weight*n[0]*n[2]; a03 += weight*n[0]*d;
+      a11 += weight*n[1]*n[1]; a12 += weight*n[1]*n[2]; a13 += weight*n[1]*d;
+      a22 += weight*n[2]*n[2]; a23 += weight*n[2]*d;
+      a33 += weight*d*d;
+    }
+
+    void add(const LodQuadric& q)
+    {
+      a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+      a11 += q.a11; a12 += q.a12; a13 += q.a13;
+      a22 += q.a22; a23 += q.a23;
+      a33 += q.a33;
+    }
+
+    double error(const float* p) const
+    {
+      double x = p[0], y = p[1], z = p[2];
+      return x*(a00*x + 2.0*(a01*y + a02*z + a03))
+        + y*(a11*y + 2.0*(a12*z + a13))
+        + z*(a22*z + 2.0*a23)
+        + a33;
+    }
+  };
+
+  struct LodCollapse
+  {
+    double Cost;
+    uint32_t From;
+    uint32_t To;
+  };
+
+  // Unnormalized, length equals twice the triangle area
+  void triangleNormal(const float* p0, const float* p1, const float* p2, double* n)
+  {
+    double e0[3] = { double(p1[0]) - p0[0], double(p1[1]) - p0[1], double(p1[2]) - p0[2] };
+    double e1[3] = { double(p2[0]) - p0[0], double(p2[1]) - p0[1], double(p2[2]) - p0[2] };
+    n[0] = e0[1]*e1[2] - e0[2]*e1[1];
+    n[1] = e0[2]*e1[0] - e0[0]*e1[2];
+    n[2] = e0[0]*e1[1] - e0[1]*e1[0];
+  }
+
+  double dot(const double* a, const double* b)
+  {
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+  }
+
+  uint64_t edgeKey(uint32_t v0, uint32_t v1)
+  {
+    return v0 < v1 ? ((uint64_t(v0) << 32) | v1) : ((uint64_t(v1) << 32) | v0);
+  }
+
+  class MeshSimplifier
+  {
+    public:
+      MeshSimplifier(const float* positions, size_t numVertices)
+        : Positions(positions)
+        , NumVertices(numVertices)
+      {}
+
+      void initialize(std::vector<uint32_t>& triangles);
+      void simplify(size_t targetNumTriangles);
+
+      const std::vector<uint32_t>& getTriangles() const { return Corners; }
+      const std::vector<uint32_t>& getFaceIds() const { return FaceIds; }
+
+    protected:
+      const float* pos(uint32_t vertexId) const { return Positions + 3*size_t(vertexId); }
+
+      void weldVertices(const std::vector<uint32_t>& triangles, std::vector<uint32_t>& weldedTriangles);
+      void computeQuadrics();
+      bool collapsePass(size_t targetNumTriangles);
+      bool collapseKeepsOrientation(uint32_t from, uint32_t to) const;
+      bool collapseKeepsSeams(uint32_t from, uint32_t to);
+
+      const float* Positions;
+      size_t NumVertices;
+
+      std::vector<uint32_t> Triangles; // Three welded vertex ids per triangle
+      std::vector<uint32_t> Corners; // Input vertex ids of the triangle corners, which keep the attribute seams
+      std::vector<uint32_t> FaceIds; // Input triangle for every triangle
+      std::vector<LodQuadric> Quadrics;
+      std::vector<uint32_t> Remap;
+      std::vector<uint32_t> CornerRemap;
+
+      // Per-pass scratch
+      std::vector<uint32_t> AdjacencyOffsets;
+      std::vector<uint32_t> AdjacentTriangles;
+      std::vector<uint64_t> Edges;
+      std::vector<LodCollapse> Collapses;
+      std::vector<uint8_t> Locked;
+      std::vector<std::pair<uint32_t, uint32_t>> CornerMoves; // Input vertex moves of a collapse
+  };
+
+  void MeshSimplifier::initialize(std::vector<uint32_t>& triangles)
+  {
+    std::vector<uint32_t> weldedTriangles;
+    weldVertices(triangles, weldedTriangles);
+
+    // Drop triangles that are degenerate after welding
+    size_t numInputTriangles = triangles.size() / 3;
+    Triangles.reserve(triangles.size());
+    Corners.reserve(triangles.size());
+    FaceIds.reserve(numInputTriangles);
+    for(size_t triIdx = 0; triIdx < numInputTriangles; ++triIdx)
+    {
+      const uint32_t* tri = weldedTriangles.data() + 3*triIdx;
+      if(tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0])
+        continue;
+      Triangles.insert(Triangles.end(), tri, tri+3);
+      Corners.insert(Corners.end(), triangles.data() + 3*triIdx, triangles.data() + 3*triIdx + 3);
+      FaceIds.push_back(uint32_t(triIdx));
+    }
+    std::vector<uint32_t>().swap(triangles);
+
+    Remap.resize(NumVertices);
+    CornerRemap.resize(NumVertices);
+    for(size_t i = 0; i < NumVertices; ++i)
+    {
+      Remap[i] = uint32_t(i);
+      CornerRemap[i] = uint32_t(i);
+    }
+
+    computeQuadrics();
+  }
+
+  void MeshSimplifier::weldVertices(const std::vector<uint32_t>& triangles, std::vector<uint32_t>& weldedTriangles)
+  {
+    // Separate vertices at the same position (eg. for per-face normals) would otherwise open up
+    // the surface during collapses. The lowest vertex id of each position represents the others in the
+    // welded triangles, which are only used for the collapses. The corners keep the input vertices.
+    std::vector<uint32_t> order(NumVertices);
+    for(size_t i = 0; i < NumVertices; ++i)
+      order[i] = uint32_t(i);
+
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+      {
+        const float* pa = pos(a);
+        const float* pb = pos(b);
+        if(pa[0] != pb[0]) return pa[0] < pb[0];
+        if(pa[1] != pb[1]) return pa[1] < pb[1];
+        if(pa[2] != pb[2]) return pa[2] < pb[2];
+        return a < b;
+      });
+
+    std::vector<uint32_t> representative(NumVertices);
+    for(size_t i = 0; i < NumVertices; )
+    {
+      const float* groupPos = pos(order[i]);
+      size_t groupEnd = i+1;
+      while(groupEnd < NumVertices && std::memcmp(pos(order[groupEnd]), groupPos, 3*sizeof(float)) == 0)
+        ++groupEnd;
+      for(size_t j = i; j < groupEnd; ++j)
+        representative[order[j]] = order[i];
+      i = groupEnd;
+    }
+
+    weldedTriangles.resize(triangles.size());
+    UsdBridgeParallelFor(triangles.size(), [&triangles, &weldedTriangles, &representative](size_t, size_t begin, size_t end)
+      {
+        for(size_t i = begin; i < end; ++i)
+          weldedTriangles[i] = representative[triangles[i]];
+      });
+  }
+
+  void MeshSimplifier::computeQuadrics()
+  {
+    Quadrics.assign(NumVertices, LodQuadric());
+
+    size_t numTriangles = FaceIds.size();
+    std::vector<std::pair<uint64_t, uint32_t>> triangleEdges(3*numTriangles);
+
+    for(size_t triIdx = 0; triIdx < numTriangles; ++triIdx)
+    {
+      const uint32_t* tri = Triangles.data() + 3*triIdx;
+
+      double n[3];
+      triangleNormal(pos(tri[0]), pos(tri[1]), pos(tri[2]), n);
+      double length = std::sqrt(dot(n, n));
+      if(length > 0.0)
+      {
+        n[0] /= length; n[1] /= length; n[2] /= length;
+        const float* p0 = pos(tri[0]);
+        double d = -(n[0]*p0[0] + n[1]*p0[1] + n[2]*p0[2]);
+        double area = 0.5*length;
+        for(int k = 0; k < 3; ++k)
+          Quadrics[tri[k]].addPlane(n, d, area);
+      }
+
+      for(int k = 0; k < 3; ++k)
+        triangleEdges[3*triIdx+k] = std::make_pair(edgeKey(tri[k], tri[(k+1)%3]), uint32_t(triIdx));
+    }
+
+    // Edges used by a single triangle are on the boundary
+    std::sort(triangleEdges.begin(), triangleEdges.end());
+    for(size_t i = 0; i < triangleEdges.size(); )
+    {
+      size_t next = i+1;
+      while(next < triangleEdges.size() && triangleEdges[next].first == triangleEdges[i].first)
+        ++next;
+
+      if(next == i+1)
+      {
+        uint32_t v0 = uint32_t(triangleEdges[i].first >> 32);
+        uint32_t v1 = uint32_t(triangleEdges[i].first & 0xFFFFFFFF);
+        const uint32_t* tri = Triangles.data() + 3*triangleEdges[i].second;
+
+        double faceNormal[3];
+        triangleNormal(pos(tri[0]), pos(tri[1]), pos(tri[2]), faceNormal);
+
+        const float* p0 = pos(v0);
+        const float* p1 = pos(v1);
+        double e[3] = { double(p1[0]) - p0[0], double(p1[1]) - p0[1], double(p1[2]) - p0[2] };
+        double n[3] = { e[1]*faceNormal[2] - e[2]*faceNormal[1], e[2]*faceNormal[0] - e[0]*faceNormal[2], e[0]*faceNormal[1] - e[1]*faceNormal[0] };
+        double length = std::sqrt(dot(n, n));
+        if(length > 0.0)
+        {
+          n[0] /= length; n[1] /= length; n[2] /= length;
+          double d = -(n[0]*p0[0] + n[1]*p0[1] + n[2]*p0[2]);
+          double weight = BoundaryPlaneWeight * dot(e, e);
+          Quadrics[v0].addPlane(n, d, weight);
+          Quadrics[v1].addPlane(n, d, weight);
+        }
+      }
+      i = next;
+    }
+  }
+
+  bool MeshSimplifier::collapseKeepsOrientation(uint32_t from, uint32_t to) const
+  {
+    const float* toPos = pos(to);
+    for(uint32_t adjIdx = AdjacencyOffsets[from]; adjIdx < AdjacencyOffsets[from+1]; ++adjIdx)
+    {
+      const uint32_t* tri = Triangles.data() + 3*size_t(AdjacentTriangles[adjIdx]);
+      if(tri[0] == to || tri[1] == to || tri[2] == to)
+        continue; // Removed by the collapse
+
+      const float* p[3];
+      const float* q[3];
+      for(int k = 0; k < 3; ++k)
+      {
+        p[k] = pos(tri[k]);
+        q[k] = tri[k] == from ? toPos : p[k];
+      }
+
+      double oldNormal[3], newNormal[3];
+      triangleNormal(p[0], p[1], p[2], oldNormal);
+      triangleNormal(q[0], q[1], q[2], newNormal);
+      if(dot(oldNormal, newNormal) <= 0.0)
+        return false;
+    }
+    return true;
+  }
+
+  bool MeshSimplifier::collapseKeepsSeams(uint32_t from, uint32_t to)
+  {
+    // Input vertices at the collapsed corners move to the input vertex across the collapsed edge in a removed triangle,
+    // so both sides of an attribute seam along the edge keep their own attributes. Collapses that would move a side
+    // without a removed triangle (a seam leaving the edge) onto the other side are rejected.
+    CornerMoves.clear();
+    for(uint32_t adjIdx = AdjacencyOffsets[from]; adjIdx < AdjacencyOffsets[from+1]; ++adjIdx)
+    {
+      size_t cornerOffset = 3*size_t(AdjacentTriangles[adjIdx]);
+      const uint32_t* tri = Triangles.data() + cornerOffset;
+      int fromSlot = -1, toSlot = -1;
+      for(int k = 0; k < 3; ++k)
+      {
+        if(tri[k] == from)
+          fromSlot = k;
+        else if(tri[k] == to)
+          toSlot = k;
+      }
+      if(toSlot != -1)
+        CornerMoves.emplace_back(Corners[cornerOffset+fromSlot], Corners[cornerOffset+toSlot]);
+    }
+
+    for(uint32_t adjIdx = AdjacencyOffsets[from]; adjIdx < AdjacencyOffsets[from+1]; ++adjIdx)
+    {
+      size_t cornerOffset = 3*size_t(AdjacentTriangles[adjIdx]);
+      for(int k = 0; k < 3; ++k)
+      {
+        if(Triangles[cornerOffset+k] != from)
+          continue;
+        uint32_t corner = Corners[cornerOffset+k];
+        auto moveIt = std::find_if(CornerMoves.begin(), CornerMoves.end(),
+          [corner](const std::pair<uint32_t, uint32_t>& cornerMove) { return cornerMove.first == corner; });
+        if(moveIt == CornerMoves.end())
+          return false;
+      }
+    }
+    return true;
+  }
+
+  bool MeshSimplifier::collapsePass(size_t targetNumTriangles)
+  {
+    size_t numTriangles = FaceIds.size();
+
+    // Vertex to triangle adjacency
+    AdjacencyOffsets.assign(NumVertices+1, 0);
+    for(uint32_t vertexId : Triangles)
+      ++AdjacencyOffsets[vertexId+1];
+    for(size_t i = 0; i < NumVertices; ++i)
+      AdjacencyOffsets[i+1] += AdjacencyOffsets[i];
+    AdjacentTriangles.resize(Triangles.size());
+    {
+      std::vector<uint32_t> cursor(AdjacencyOffsets.begin(), AdjacencyOffsets.end()-1);
+      for(size_t i = 0; i < Triangles.size(); ++i)
+        AdjacentTriangles[cursor[Triangles[i]]++] = uint32_t(i / 3);
+    }
+
+    // Unique edges with the cheapest of both collapse directions
+    Edges.resize(Triangles.size());
+    for(size_t triIdx = 0; triIdx < numTriangles; ++triIdx)
+    {
+      const uint32_t* tri = Triangles.data() + 3*triIdx;
+      for(int k = 0; k < 3; ++k)
+        Edges[3*triIdx+k] = edgeKey(tri[k], tri[(k+1)%3]);
+    }
+    std::sort(Edges.begin(), Edges.end());
+    Edges.erase(std::unique(Edges.begin(), Edges.end()), Edges.end());
+
+    Collapses.resize(Edges.size());
+    UsdBridgeParallelFor(Edges.size(), [this](size_t, size_t begin, size_t end)
+      {
+        for(size_t i = begin; i < end; ++i)
+        {
+          uint32_t v0 = uint32_t(Edges[i] >> 32);
+          uint32_t v1 = uint32_t(Edges[i] & 0xFFFFFFFF);
+          const LodQuadric& q0 = Quadrics[v0];
+          const LodQuadric& q1 = Quadrics[v1];
+          double costTo0 = q0.error(pos(v0)) + q1.error(pos(v0));
+          double costTo1 = q0.error(pos(v1)) + q1.error(pos(v1));
+          Collapses[i] = (costTo0 <= costTo1) ? LodCollapse{costTo0, v1, v0} : LodCollapse{costTo1, v0, v1};
+        }
+      });
+    std::sort(Collapses.begin(), Collapses.end(), [](const LodCollapse& a, const LodCollapse& b)
+      {
+        return a.Cost < b.Cost || (a.Cost == b.Cost && a.From < b.From);
+      });
+
+    // Greedily pick independent collapses, locking the neighborhood of each so the
+    // adjacency and orientation checks remain valid for the rest of the pass.
+    Locked.assign(NumVertices, 0);
+    size_t trianglesToRemove = numTriangles - targetNumTriangles;
+    size_t numRemoved = 0;
+    size_t numCollapses = 0;
+    for(const LodCollapse& collapse : Collapses)
+    {
+      if(numRemoved >= trianglesToRemove)
+        break;
+      if(Locked[collapse.From] || Locked[collapse.To])
+        continue;
+      if(!collapseKeepsOrientation(collapse.From, collapse.To))
+        continue;
+
+      if(!collapseKeepsSeams(collapse.From, collapse.To))
+        continue;
+
+      for(uint32_t adjIdx = AdjacencyOffsets[collapse.From]; adjIdx < AdjacencyOffsets[collapse.From+1]; ++adjIdx)
+      {
+        const uint32_t* tri = Triangles.data() + 3*size_t(AdjacentTriangles[adjIdx]);
+        bool removed = false;
+        for(int k = 0; k < 3; ++k)
+        {
+          Locked[tri[k]] = 1;
+          removed |= (tri[k] == collapse.To);
+        }
+        if(removed)
+          ++numRemoved;
+      }
+
+      for(const std::pair<uint32_t, uint32_t>& cornerMove : CornerMoves)
+        CornerRemap[cornerMove.first] = cornerMove.second;
+      Remap[collapse.From] = collapse.To;
+      Quadrics[collapse.To].add(Quadrics[collapse.From]);
+      ++numCollapses;
+    }
+
+    if(!numCollapses)
+      return false;
+
+    // Apply the collapses and drop the triangles that became degenerate
+    size_t dstIdx = 0;
+    for(size_t triIdx = 0; triIdx < numTriangles; ++triIdx)
+    {
+      uint32_t v0 = Remap[Triangles[3*triIdx]];
+      uint32_t v1 = Remap[Triangles[3*triIdx+1]];
+      uint32_t v2 = Remap[Triangles[3*triIdx+2]];
+      if(v0 == v1 || v1 == v2 || v2 == v0)
+        continue;
+      Triangles[3*dstIdx] = v0;
+      Triangles[3*dstIdx+1] = v1;
+      Triangles[3*dstIdx+2] = v2;
+      for(int k = 0; k < 3; ++k)
+        Corners[3*dstIdx+k] = CornerRemap[Corners[3*triIdx+k]];
+      FaceIds[dstIdx] = FaceIds[triIdx];
+      ++dstIdx;
+    }
+    Triangles.resize(3*dstIdx);
+    Corners.resize(3*dstIdx);
+    FaceIds.resize(dstIdx);
+
+    return true;
+  }
+
+  void MeshSimplifier::simplify(size_t targetNumTriangles)
+  {
+    while(FaceIds.size() > targetNumTriangles && collapsePass(targetNumTriangles))
+    {}
+  }
+
+  void assembleLod(const UsdBridgeMeshData& meshData, const std::vector<uint32_t>& triangles, const std::vector<uint32_t>& faceIds,
+    std::vector<uint32_t>& newVertexIds, UsdGeometryLod& lod)
+  {
+    // Compact the remaining vertices, keeping their original order
+    std::vector<uint32_t> vertexIds;
+    newVertexIds.assign(meshData.NumPoints, InvalidVertexId);
+    for(uint32_t vertexId : triangles)
+      newVertexIds[vertexId] = 0;
+    for(size_t i = 0; i < meshData.NumPoints; ++i)
+    {
+      if(newVertexIds[i] != InvalidVertexId)
+      {
+        newVertexIds[i] = uint32_t(vertexIds.size());
+        vertexIds.push_back(uint32_t(i));
+      }
+    }
+
+    lod.Indices.resize(triangles.size());
+    for(size_t i = 0; i < triangles.size(); ++i)
+      lod.Indices[i] = newVertexIds[triangles[i]];
+
+    GatherElements(meshData.Points, UsdBridgeTypeSize(meshData.PointsType), vertexIds, lod.Points);
+    if(meshData.Normals)
+      GatherElements(meshData.Normals, UsdBridgeTypeSize(meshData.NormalsType), meshData.PerPrimNormals ? faceIds : vertexIds, lod.Normals);
+    if(meshData.Colors)
+      GatherElements(meshData.Colors, UsdBridgeTypeSize(meshData.ColorsType), meshData.PerPrimColors ? faceIds : vertexIds, lod.Colors);
+
+    lod.Attributes.assign(meshData.Attributes, meshData.Attributes + meshData.NumAttributes);
+    lod.AttributeData.resize(meshData.NumAttributes);
+    for(uint32_t attribIdx = 0; attribIdx < meshData.NumAttributes; ++attribIdx)
+    {
+      UsdBridgeAttribute& attrib = lod.Attributes[attribIdx];
+      if(attrib.Data)
+      {
+        GatherElements(attrib.Data, UsdBridgeTypeSize(attrib.DataType), attrib.PerPrimData ? faceIds : vertexIds, lod.AttributeData[attribIdx]);
+        attrib.Data = lod.AttributeData[attribIdx].data();
+      }
+    }
+
+    UsdBridgeMeshData& lodData = lod.MeshData;
+    lodData = meshData;
+    lodData.NumPoints = vertexIds.size();
+    lodData.Points = lod.Points.data();
+    lodData.Normals = meshData.Normals ? lod.Normals.data() : nullptr;
+    lodData.Colors = meshData.Colors ? lod.Colors.data() : nullptr;
+    lodData.Attributes = lod.Attributes.data();
+    lodData.Indices = lod.Indices.data();
+    lodData.IndicesType = UsdBridgeType::UINT;
+    lodData.NumIndices = lod.Indices.size();
+    lodData.FaceVertexCount = 3;
+  }
+}
+
+bool GenerateMeshLods(const UsdBridgeMeshData& meshData, const float* ratios, size_t numRatios, std::vector<UsdGeometryLod>& lods)
+{
+  lods.clear();
+
+  uint64_t numPoints = meshData.NumPoints;
+  if(meshData.FaceVertexCount != 3 || numPoints >= InvalidVertexId || !meshData.Points)
+    return false;
+
+  // Positions in single precision, vertex ids in 32 bits
+  std::vector<float> convertedPositions;
+  const float* positions = static_cast<const float*>(meshData.Points);
+  if(meshData.PointsType == UsdBridgeType::DOUBLE3)
+  {
+    const double* srcPositions = static_cast<const double*>(meshData.Points);
+    convertedPositions.resize(3*numPoints);
+    for(size_t i = 0; i < convertedPositions.size(); ++i)
+      convertedPositions[i] = float(srcPositions[i]);
+    positions = convertedPositions.data();
+  }
+  else if(meshData.PointsType != UsdBridgeType::FLOAT3)
+    return false;
+
+  uint64_t numIndices = meshData.Indices ? meshData.NumIndices : numPoints;
+  std::vector<uint32_t> triangles(numIndices - numIndices % 3);
+  if(meshData.Indices)
+  {
+    if(!CopyIndicesToUint32(meshData.Indices, meshData.IndicesType, numPoints, triangles))
+      return false;
+  }
+  else
+  {
+    for(size_t i = 0; i < triangles.size(); ++i)
+      triangles[i] = uint32_t(i);
+  }
+
+  size_t numInputTriangles = triangles.size() / 3;
+
+  MeshSimplifier simplifier(positions, numPoints);
+  simplifier.initialize(triangles);
+
+  // Data of each level refers to its own buffers, so size the list upfront
+  lods.resize(numRatios);
+  std::vector<uint32_t> newVertexIds;
+  for(size_t levelIdx = 0; levelIdx < numRatios; ++levelIdx)
+  {
+    size_t targetNumTriangles = std::max<size_t>(1, size_t(double(ratios[levelIdx]) * numInputTriangles));
+    simplifier.simplify(targetNumTriangles);
+
+    assembleLod(meshData, simplifier.getTriangles(), simplifier.getFaceIds(), newVertexIds, lods[levelIdx]);
+  }
+
+  return true;
+}
@@ -0,0 +1,30 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "UsdBridgeData.h"
+
+#include <vector>
+
+// Reduced-resolution version of a triangle mesh. MeshData refers to the buffers owned by this object,
+// so it should not be copied or moved after generation.
+struct UsdGeometryLod
+{
+  UsdBridgeMeshData MeshData;
+
+  std::vector<char> Points;
+  std::vector<char> Normals;
+  std::vector<char> Colors;
+  std::vector<uint32_t> Indices;
+  std::vector<UsdBridgeAttribute> Attributes;
+  std::vector<std::vector<char>> AttributeData;
+};
+
+// Simplifies a triangle mesh through quadric error metric edge collapses, into one level per entry of
+// ratios (fraction of the input triangle count, in decreasing order). Each level is simplified further from
+// the previous one. Remaining vertices are a subset of the input vertices, so per-vertex and per-face
+// data is carried over without resampling. Vertices at the same position are welded for the collapses, while
+// the seams between them (in normals, colors or attributes) are kept in the output.
+// Returns false if the mesh data cannot be simplified (unsupported position or index types, invalid indices).
+bool GenerateMeshLods(const UsdBridgeMeshData& meshData, const float* ratios, size_t numRatios, std::vector<UsdGeometryLod>& lods);
@@ -0,0 +1,177 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "UsdGeometryReorder.h"
+#include "UsdGeometryGather.h"
+#include "UsdBridgeUtils.h"
+
+namespace
+{
+  // Post-transform cache size the face order is optimized for
+  static constexpr int64_t VertexCacheSize = 16;
+
+  static constexpr uint32_t InvalidId = ~uint32_t(0);
+
+  // Tipsify (Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"), for faces of any
+  // fixed size. Fans out around the current vertex, then continues with the vertex that is still in cache and has
+  // the fewest remaining faces.
+  void tipsifyFaces(const std::vector<uint32_t>& indices, size_t faceSize, size_t numVertices, std::vector<uint32_t>& faceOrder)
+  {
+    size_t numFaces = indices.size() / faceSize;
+
+    // Vertex to face adjacency
+    std::vector<uint32_t> adjOffsets(numVertices+1, 0);
+    for(uint32_t vertexId : indices)
+      ++adjOffsets[vertexId+1];
+    for(size_t i = 0; i < numVertices; ++i)
+      adjOffsets[i+1] += adjOffsets[i];
+    std::vector<uint32_t> adjFaces(indices.size());
+    {
+      std::vector<uint32_t> cursor(adjOffsets.begin(), adjOffsets.end()-1);
+      for(size_t i = 0; i < indices.size(); ++i)
+        adjFaces[cursor[indices[i]]++] = uint32_t(i / faceSize);
+    }
+
+    std::vector<uint32_t> liveFaces(numVertices);
+    for(size_t i = 0; i < numVertices; ++i)
+      liveFaces[i] = adjOffsets[i+1] - adjOffsets[i];
+
+    std::vector<int64_t> cacheTime(numVertices, 0);
+    std::vector<uint8_t> emitted(numFaces, 0);
+    std::vector<uint32_t> deadEnds;
+    std::vector<uint32_t> candidates;
+
+    faceOrder.clear();
+    faceOrder.reserve(numFaces);
+
+    int64_t time = VertexCacheSize + 1;
+    size_t cursor = 0;
+    uint32_t fanVertex = numFaces ? indices[0] : InvalidId;
+    while(fanVertex != InvalidId)
+    {
+      candidates.clear();
+      for(uint32_t adjIdx = adjOffsets[fanVertex]; adjIdx < adjOffsets[fanVertex+1]; ++adjIdx)
+      {
+        uint32_t faceIdx = adjFaces[adjIdx];
+        if(emitted[faceIdx])
+          continue;
+        emitted[faceIdx] = 1;
+        faceOrder.push_back(faceIdx);
+
+        const uint32_t* face = indices.data() + faceIdx*faceSize;
+        for(size_t k = 0; k < faceSize; ++k)
+        {
+          uint32_t vertexId = face[k];
+          deadEnds.push_back(vertexId);
+          candidates.push_back(vertexId);
+          --liveFaces[vertexId];
+          if(time - cacheTime[vertexId] > VertexCacheSize)
+            cacheTime[vertexId] = time++;
+        }
+      }
+
+      // Pick the candidate that stays in cache longest while its remaining faces are emitted
+      uint32_t nextVertex = InvalidId;
+      int64_t bestPriority = -1;
+      for(uint32_t vertexId : candidates)
+      {
+        if(!liveFaces[vertexId])
+          continue;
+        int64_t priority = 0;
+        if(time - cacheTime[vertexId] + 2*int64_t(liveFaces[vertexId]) <= VertexCacheSize)
+          priority = time - cacheTime[vertexId];
+        if(priority > bestPriority)
+        {
+          bestPriority = priority;
+          nextVertex = vertexId;
+        }
+      }
+
+      // Dead end: go back to recently used vertices, otherwise continue in input order
+      while(nextVertex == InvalidId && !deadEnds.empty())
+      {
+        uint32_t vertexId = deadEnds.back();
+        deadEnds.pop_back();
+        if(liveFaces[vertexId])
+          nextVertex = vertexId;
+      }
+      while(nextVertex == InvalidId && cursor < numVertices)
+      {
+        if(liveFaces[cursor])
+          nextVertex = uint32_t(cursor);
+        ++cursor;
+      }
+
+      fanVertex = nextVertex;
+    }
+  }
+}
+
+bool ReorderMeshForLocality(UsdBridgeMeshData& meshData, UsdGeometryReorderedMesh& reorderedMesh)
+{
+  uint64_t numPoints = meshData.NumPoints;
+  size_t faceSize = size_t(meshData.FaceVertexCount);
+  if(!meshData.Indices || !meshData.Points || !faceSize || numPoints >= InvalidId || (meshData.NumIndices % faceSize))
+    return false;
+
+  std::vector<uint32_t> indices(meshData.NumIndices);
+  if(!CopyIndicesToUint32(meshData.Indices, meshData.IndicesType, numPoints, indices))
+    return false;
+
+  std::vector<uint32_t> faceOrder;
+  tipsifyFaces(indices, faceSize, numPoints, faceOrder);
+
+  // Number vertices by first use in the new face order, unused vertices go last
+  std::vector<uint32_t> newVertexIds(numPoints, InvalidId);
+  std::vector<uint32_t> vertexOrder;
+  vertexOrder.reserve(numPoints);
+  reorderedMesh.Indices.resize(indices.size());
+  for(size_t i = 0; i < faceOrder.size(); ++i)
+  {
+    const uint32_t* face = indices.data() + faceOrder[i]*faceSize;
+    for(size_t k = 0; k < faceSize; ++k)
+    {
+      uint32_t& newId = newVertexIds[face[k]];
+      if(newId == InvalidId)
+      {
+        newId = uint32_t(vertexOrder.size());
+        vertexOrder.push_back(face[k]);
+      }
+      reorderedMesh.Indices[i*faceSize + k] = newId;
+    }
+  }
+  for(size_t i = 0; i < numPoints; ++i)
+  {
+    if(newVertexIds[i] == InvalidId)
+      vertexOrder.push_back(uint32_t(i));
+  }
+
+  GatherElements(meshData.Points, UsdBridgeTypeSize(meshData.PointsType), vertexOrder, reorderedMesh.Points);
+  if(meshData.Normals)
+    GatherElements(meshData.Normals, UsdBridgeTypeSize(meshData.NormalsType), meshData.PerPrimNormals ? faceOrder : vertexOrder, reorderedMesh.Normals);
+  if(meshData.Colors)
+    GatherElements(meshData.Colors, UsdBridgeTypeSize(meshData.ColorsType), meshData.PerPrimColors ? faceOrder : vertexOrder, reorderedMesh.Colors);
+
+  reorderedMesh.Attributes.assign(meshData.Attributes, meshData.Attributes + meshData.NumAttributes);
+  reorderedMesh.AttributeData.resize(meshData.NumAttributes);
+  for(uint32_t attribIdx = 0; attribIdx < meshData.NumAttributes; ++attribIdx)
+  {
+    UsdBridgeAttribute& attrib = reorderedMesh.Attributes[attribIdx];
+    if(attrib.Data)
+    {
+      GatherElements(attrib.Data, UsdBridgeTypeSize(attrib.DataType), attrib.PerPrimData ? faceOrder : vertexOrder, reorderedMesh.AttributeData[attribIdx]);
+      attrib.Data = reorderedMesh.AttributeData[attribIdx].data();
+    }
+  }
+
+  meshData.Points = reorderedMesh.Points.data();
+  if(meshData.Normals)
+    meshData.Normals = reorderedMesh.Normals.data();
+  if(meshData.Colors)
+    meshData.Colors = reorderedMesh.Colors.data();
+  meshData.Attributes = reorderedMesh.Attributes.data();
+  meshData.Indices = reorderedMesh.Indices.data();
+  meshData.IndicesType = UsdBridgeType::UINT;
+
+  return true;
+}
@@ -0,0 +1,25 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "UsdBridgeData.h"
+
+#include <vector>
+
+// Buffers holding the reordered data of a mesh, referred to by the mesh data after reordering
+struct UsdGeometryReorderedMesh
+{
+  std::vector<char> Points;
+  std::vector<char> Normals;
+  std::vector<char> Colors;
+  std::vector<uint32_t> Indices;
+  std::vector<UsdBridgeAttribute> Attributes;
+  std::vector<std::vector<char>> AttributeData;
+};
+
+// Reorders the faces of an indexed mesh for vertex cache locality (Tipsify), after which vertices are
+// renumbered in order of first use. All per-vertex and per-face arrays are permuted accordingly and stored in
+// reorderedMesh, to which the pointers in meshData are redirected.
+// Returns false and leaves meshData untouched if the mesh cannot be reordered (no or out of range indices).
+bool ReorderMeshForLocality(UsdBridgeMeshData& meshData, UsdGeometryReorderedMesh& reorderedMesh);
@@ -24,15 +24,20 @@ DEFINE_PARAMETER_MAP(UsdWorld,
   REGISTER_PARAMETER_MACRO("instance", ANARI_ARRAY, instances)
   REGISTER_PARAMETER_MACRO("surface", ANARI_ARRAY, surfaces)
   REGISTER_PARAMETER_MACRO("volume", ANARI_ARRAY, volumes)
+  REGISTER_PARAMETER_MACRO("usd::instancing", ANARI_BOOL, instancing)
 )
 
-UsdWorld::UsdWorld(const char* name, UsdBridge* bridge)
+UsdWorld::UsdWorld(const char* name, UsdBridge* bridge, UsdDevice* device)
   : BridgedBaseObjectType(ANARI_WORLD, name, bridge)
+  , usdDevice(device)
 {
+  usdDevice->addToWorldList(this);
 }
 
 UsdWorld::~UsdWorld()
 {
+  usdDevice->removeFromWorldList(this);
+
 #ifdef OBJECT_LIFETIME_EQUALS_USD_LIFETIME
   if(usdBridge)
     usdBridge->DeleteWorld(usdHandle);
@@ -83,6 +88,12 @@ bool UsdWorld::doCommitData(UsdDevice* device)
 
     paramChanged = false;
   }
+  else if (instancersDirty && getReadParams().instancing)
+  {
+    UsdLogInfo logInfo(device, this, ANARI_WORLD, this->getName());
+    commitInstancers(getReadParams().timeVarying & 1, device->getReadParams().timeStep, logInfo);
+  }
+  instancersDirty = false;
 
   return false;
 }
@@ -100,9 +111,23 @@ void UsdWorld::doCommitRefs(UsdDevice* device)
 
   UsdLogInfo logInfo(device, this, ANARI_WORLD, this->getName());
 
-  ManageRefArray<InstanceType, ANARIInstance, UsdInstance>(usdHandle, paramData.instances, instancesTimeVarying, timeStep,
-    instanceHandles, &UsdBridge::SetInstanceRefs, &UsdBridge::DeleteInstanceRefs,
-    usdBridge, logInfo, "UsdWorld commit failed: 'instance' array elements should be of type ANARI_INSTANCE");
+  if(paramData.instancing)
+  {
+    commitInstancers(instancesTimeVarying, timeStep, logInfo);
+  }
+  else
+  {
+    if(instancersWritten)
+    {
+      usdBridge->DeleteInstancerRefs(usdHandle, instancesTimeVarying, timeStep);
+      instancersWritten = false;
+    }
+
+    ManageRefArray<InstanceType, ANARIInstance, UsdInstance>(usdHandle, paramData.instances, instancesTimeVarying, timeStep,
+      instanceHandles, &UsdBridge::SetInstanceRefs, &UsdBridge::DeleteInstanceRefs,
+      usdBridge, logInfo, "UsdWorld commit failed: 'instance' array elements should be of type ANARI_INSTANCE");
+    instanceRefsWritten = true;
+  }
 
   ManageRefArray<SurfaceType, ANARISurface, UsdSurface>(usdHandle, paramData.surfaces, surfacesTimeVarying, timeStep,
     surfaceHandles, &UsdBridge::SetSurfaceRefs, &UsdBridge::DeleteSurfaceRefs,
@@ -111,4 +136,73 @@ void UsdWorld::doCommitRefs(UsdDevice* device)
   ManageRefArray<VolumeType, ANARIVolume, UsdVolume>(usdHandle, paramData.volumes, volumesTimeVarying, timeStep,
     volumeHandles, &UsdBridge::SetVolumeRefs, &UsdBridge::DeleteVolumeRefs,
     usdBridge, logInfo, "UsdGroup commit failed: 'volume' array elements should be of type ANARI_VOLUME");
-}
\ No newline at end of file
+}
+
+void UsdWorld::commitInstancers(bool instancesTimeVarying, double timeStep, UsdLogInfo& logInfo)
+{
+  const UsdWorldData& paramData = getReadParams();
+
+  instancersDirty = false;
+
+  if(!AssertArrayType(paramData.instances, InstanceType, logInfo, "UsdWorld commit failed: 'instance' array elements should be of type ANARI_INSTANCE"))
+    return;
+
+  // Compare against the instances of the previous write, per index
+  uint64_t numInstances = paramData.instances ? paramData.instances->getLayout().numItems1 : 0;
+  bool instancesChanged = !instancersWritten || numInstances != instanceHandles.size();
+  if(paramData.instances)
+  {
+    const ANARIInstance* instances = reinterpret_cast<const ANARIInstance*>(paramData.instances->getData());
+
+    instanceHandles.resize(numInstances);
+    instancerGroupHandles.resize(numInstances);
+    instancerTransforms.resize(numInstances*16);
+    for (uint64_t i = 0; i < numInstances; ++i)
+    {
+      const UsdInstance* usdInstance = reinterpret_cast<const UsdInstance*>(instances[i]);
+      const UsdInstanceData& instanceData = usdInstance->getReadParams();
+
+      UsdInstanceHandle instanceHandle = usdInstance->getUsdHandle();
+      UsdGroupHandle groupHandle = instanceData.group ? instanceData.group->getUsdHandle() : UsdGroupHandle();
+
+      float bridgeTransform[16];
+      for(int row = 0; row < 4; ++row)
+      {
+        memcpy(&bridgeTransform[row*4], &instanceData.transform[row*3], 3 * sizeof(float));
+        bridgeTransform[row*4+3] = 0.0f;
+      }
+      bridgeTransform[15] = 1.0f;
+
+      float* prevTransform = &instancerTransforms[i*16];
+      if(instanceHandles[i].value != instanceHandle.value || instancerGroupHandles[i].value != groupHandle.value ||
+        memcmp(prevTransform, bridgeTransform, sizeof(bridgeTransform)) != 0)
+      {
+        instanceHandles[i] = instanceHandle;
+        instancerGroupHandles[i] = groupHandle;
+        memcpy(prevTransform, bridgeTransform, sizeof(bridgeTransform));
+        instancesChanged = true;
+      }
+    }
+  }
+  else
+  {
+    instanceHandles.resize(0);
+    instancerGroupHandles.resize(0);
+    instancerTransforms.resize(0);
+  }
+
+  // Time-varying instancers still receive a sample at this timestep
+  if(!instancesChanged && !instancesTimeVarying)
+    return;
+
+  usdBridge->SetInstancerRefs(usdHandle, instanceHandles.data(), instancerGroupHandles.data(), instancerTransforms.data(), numInstances,
+    instancesTimeVarying, timeStep);
+  instancersWritten = true;
+
+  // The instances keep their prims, but are no longer referenced from the world
+  if(instanceRefsWritten)
+  {
+    usdBridge->DeleteInstanceRefs(usdHandle, instancesTimeVarying, timeStep);
+    instanceRefsWritten = false;
+  }
+}
@@ -6,6 +6,7 @@
 #include "UsdBridgedBaseObject.h"
 
 class UsdDataArray;
+class UsdDevice;
 
 struct UsdWorldData
 {
@@ -16,12 +17,14 @@ struct UsdWorldData
   UsdDataArray* instances = nullptr;
   UsdDataArray* surfaces = nullptr;
   UsdDataArray* volumes = nullptr;
+
+  bool instancing = false; // Write the instances as point instancers, one per group
 };
 
 class UsdWorld : public UsdBridgedBaseObject<UsdWorld, UsdWorldData, UsdWorldHandle>
 {
   public:
-    UsdWorld(const char* name, UsdBridge* bridge);
+    UsdWorld(const char* name, UsdBridge* bridge, UsdDevice* device);
     ~UsdWorld();
 
     void filterSetParam(const char *name,
@@ -32,12 +35,25 @@ class UsdWorld : public UsdBridgedBaseObject<UsdWorld, UsdWorldData, UsdWorldHan
     void filterResetParam(
       const char *name) override;
 
+    // Instances written as point instancers have no prims of their own in the world,
+    // so their commits have to be written by the world's instancers
+    void setInstancersDirty() { instancersDirty = true; }
+
   protected:
     bool deferCommit(UsdDevice* device) override;
     bool doCommitData(UsdDevice* device) override;
     void doCommitRefs(UsdDevice* device) override;
 
+    void commitInstancers(bool instancesTimeVarying, double timeStep, UsdLogInfo& logInfo);
+
     std::vector<UsdInstanceHandle> instanceHandles; // for convenience
+    std::vector<UsdGroupHandle> instancerGroupHandles; // for convenience
+    std::vector<float> instancerTransforms; // for convenience
+    bool instancersWritten = false;
+    bool instancersDirty = false;
+    bool instanceRefsWritten = false;
     std::vector<UsdSurfaceHandle> surfaceHandles; // for convenience
     std::vector<UsdVolumeHandle> volumeHandles; // for convenience
+
+    UsdDevice* usdDevice = nullptr;
 };
\ No newline at end of file